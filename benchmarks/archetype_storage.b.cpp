@@ -0,0 +1,93 @@
+#include "archetype_storage.hpp"
+
+#include <cstdint>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A component with a single float. Only for benchmarking purposes.
+    template <int N>
+    struct value {
+        float v { 1.0 };
+    };
+
+    void BM_ArchetypeStorage_Insert(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            archetype_storage storage;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                const auto entity { static_cast<eecs::entity>(i) };
+                storage.insert(entity, value<0> {});
+                storage.insert(entity, value<1> {});
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ArchetypeStorage_EachFive(::benchmark::State& state)
+    {
+        archetype_storage storage;
+        for (int64_t i { 0 }; i < state.range(0); ++i) {
+            const auto entity { static_cast<eecs::entity>(i) };
+            storage.insert(entity, value<0> {});
+            storage.insert(entity, value<1> {});
+            storage.insert(entity, value<2> {});
+            storage.insert(entity, value<3> {});
+            storage.insert(entity, value<4> {});
+        }
+
+        for (auto _ : state) {
+            storage.each<value<0>, value<1>, value<2>, value<3>, value<4>>(
+                [](const entity /*unused*/, value<0>& a, const value<1>& b,
+                    const value<2>& c, const value<3>& d, const value<4>& e) {
+                    a.v += b.v * c.v + d.v * e.v;
+                });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_ViewFive(::benchmark::State& state)
+    {
+        world world;
+        for (int64_t i { 0 }; i < state.range(0); ++i) {
+            const entity entity { world.create() };
+            world.insert(entity, value<0> {});
+            world.insert(entity, value<1> {});
+            world.insert(entity, value<2> {});
+            world.insert(entity, value<3> {});
+            world.insert(entity, value<4> {});
+        }
+
+        for (auto _ : state) {
+            world.view<value<0>, value<1>, value<2>, value<3>, value<4>>(
+                [](const entity /*unused*/, value<0>& a, const value<1>& b,
+                    const value<2>& c, const value<3>& d, const value<4>& e) {
+                    a.v += b.v * c.v + d.v * e.v;
+                });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_ArchetypeStorage_Insert)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK(BM_ArchetypeStorage_EachFive)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_ViewFive)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+
+} // namespace eecs::benchmark
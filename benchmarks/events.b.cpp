@@ -0,0 +1,44 @@
+#include "events.hpp"
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A collision event. Only for benchmarking purposes.
+    struct collision {
+        uint32_t first;
+        uint32_t second;
+        float impulse;
+    };
+
+    void BM_Events_SendReadUpdate(::benchmark::State& state)
+    {
+        events<collision> channel;
+        events<collision>::reader reader;
+        const auto count { static_cast<uint32_t>(state.range(0)) };
+
+        for (auto _ : state) {
+            for (uint32_t i { 0 }; i < count; ++i) {
+                channel.send(
+                    collision { .first = i, .second = i + 1, .impulse = 1.0 });
+            }
+
+            float total { 0.0 };
+            channel.each(reader,
+                [&total](const collision& event) { total += event.impulse; });
+            ::benchmark::DoNotOptimize(total);
+            channel.update();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_Events_SendReadUpdate)->Arg(1024)->Arg(65536);
+
+} // namespace eecs::benchmark
@@ -0,0 +1,58 @@
+#include "schedule.hpp"
+
+#include <cstdint>
+
+#include "access.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A counter component. Only for benchmarking purposes.
+    struct counter {
+        int64_t value { 0 };
+    };
+
+    void empty_system(world& /*world*/) { }
+
+    void BM_Schedule_Run(::benchmark::State& state)
+    {
+        schedule schedule;
+        for (int64_t i { 0 }; i < state.range(0); ++i) {
+            schedule.add_system(empty_system);
+        }
+        world world;
+
+        for (auto _ : state) {
+            schedule.run(world);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_Schedule_RunOnPool(::benchmark::State& state)
+    {
+        schedule schedule;
+        for (int64_t i { 0 }; i < state.range(0); ++i) {
+            schedule.add_system<reads<counter>>(empty_system);
+        }
+        world world;
+        thread_pool pool;
+
+        for (auto _ : state) {
+            schedule.run(world, pool);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_Schedule_Run)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_Schedule_RunOnPool)->RangeMultiplier(4)->Range(1, 64);
+
+} // namespace eecs::benchmark
@@ -0,0 +1,68 @@
+#include "snapshot.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A transform component. Only for benchmarking purposes.
+    struct transform {
+        float position[3] { 0.0, 0.0, 0.0 };
+        float rotation[4] { 0.0, 0.0, 0.0, 1.0 };
+    };
+
+    /// Populates a `::world` with `count` entities that all have a
+    /// `::transform`.
+    void populate(world& world, const int64_t count)
+    {
+        const std::vector<entity> entities { world.create(
+            static_cast<std::size_t>(count)) };
+        const std::vector<transform> transforms(entities.size());
+        world.insert<transform>(entities, transforms);
+    }
+
+    void BM_Snapshot_Capture(::benchmark::State& state)
+    {
+        world world;
+        populate(world, state.range(0));
+        snapshot snapshot;
+        snapshot.component<transform>("transform");
+
+        for (auto _ : state) {
+            ::benchmark::DoNotOptimize(snapshot.capture(world));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_Snapshot_Restore(::benchmark::State& state)
+    {
+        world source;
+        populate(source, state.range(0));
+        snapshot snapshot;
+        snapshot.component<transform>("transform");
+        const std::vector<std::byte> image { snapshot.capture(source) };
+        world target;
+
+        for (auto _ : state) {
+            snapshot.restore(target, image);
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+} // namespace
+
+BENCHMARK(BM_Snapshot_Capture)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_Snapshot_Restore)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+
+} // namespace eecs::benchmark
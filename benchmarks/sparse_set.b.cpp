@@ -0,0 +1,115 @@
+#include "sparse_set.hpp"
+
+#include <cstdint>
+
+#include "types.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A 2D vector component. Only for benchmarking purposes.
+    struct vec2 {
+        float x { 0.0 };
+        float y { 0.0 };
+    };
+
+    void BM_SparseSet_Insert(::benchmark::State& state)
+    {
+        const auto count { static_cast<u32>(state.range(0)) };
+
+        for (auto _ : state) {
+            sparse_set<vec2> set;
+            for (u32 id { 0 }; id < count; ++id) {
+                set.insert(id, vec2 {});
+            }
+            ::benchmark::DoNotOptimize(set.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_SparseSet_Emplace(::benchmark::State& state)
+    {
+        const auto count { static_cast<u32>(state.range(0)) };
+
+        for (auto _ : state) {
+            sparse_set<vec2> set;
+            for (u32 id { 0 }; id < count; ++id) {
+                set.emplace(id, 1.0F, 2.0F);
+            }
+            ::benchmark::DoNotOptimize(set.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_SparseSet_Erase(::benchmark::State& state)
+    {
+        const auto count { static_cast<u32>(state.range(0)) };
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            sparse_set<vec2> set;
+            for (u32 id { 0 }; id < count; ++id) {
+                set.insert(id, vec2 {});
+            }
+            state.ResumeTiming();
+
+            for (u32 id { 0 }; id < count; ++id) {
+                set.erase(id);
+            }
+            ::benchmark::DoNotOptimize(set.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_SparseSet_Find(::benchmark::State& state)
+    {
+        const auto count { static_cast<u32>(state.range(0)) };
+
+        sparse_set<vec2> set;
+        for (u32 id { 0 }; id < count; id += 2) {
+            set.insert(id, vec2 {});
+        }
+
+        for (auto _ : state) {
+            for (u32 id { 0 }; id < count; ++id) {
+                ::benchmark::DoNotOptimize(set.find(id));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+    void BM_SparseSet_Iterate(::benchmark::State& state)
+    {
+        const auto count { static_cast<u32>(state.range(0)) };
+
+        sparse_set<vec2> set;
+        for (u32 id { 0 }; id < count; ++id) {
+            set.insert(id, vec2 { .x = 1.0, .y = 2.0 });
+        }
+
+        for (auto _ : state) {
+            for (vec2& value : set) {
+                value.x += value.y;
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * count);
+    }
+
+} // namespace
+
+BENCHMARK(BM_SparseSet_Insert)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_SparseSet_Emplace)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_SparseSet_Erase)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_SparseSet_Find)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_SparseSet_Iterate)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+
+} // namespace eecs::benchmark
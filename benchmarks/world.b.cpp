@@ -0,0 +1,286 @@
+#include "world.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "entity.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace eecs::benchmark {
+
+namespace {
+
+    /// A position component. Only for benchmarking purposes.
+    struct position {
+        float x { 0.0 };
+        float y { 0.0 };
+    };
+
+    /// A velocity component. Only for benchmarking purposes.
+    struct velocity {
+        float dx { 1.0 };
+        float dy { 1.0 };
+    };
+
+    /// A settings resource. Only for benchmarking purposes.
+    struct settings {
+        float gravity { 9.81 };
+    };
+
+    /// Populates a `::world` with `count` entities that all have a
+    /// `::position`, of which `overlap` percent also have a `::velocity`.
+    void populate(world& world, const int64_t count, const int64_t overlap)
+    {
+        for (int64_t i { 0 }; i < count; ++i) {
+            const entity entity { world.create() };
+            world.insert(entity, position {});
+            if (i * overlap / 100 != (i + 1) * overlap / 100) {
+                world.insert(entity, velocity {});
+            }
+        }
+    }
+
+    void BM_World_Create(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            world world;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                ::benchmark::DoNotOptimize(world.create());
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_CreateMany(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            world world;
+            ::benchmark::DoNotOptimize(
+                world.create(static_cast<std::size_t>(state.range(0))));
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_Insert(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            world world;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                world.insert(world.create(), position {});
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_InsertMany(::benchmark::State& state)
+    {
+        const std::vector<position> positions(
+            static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            world world;
+            const std::vector<entity> entities { world.create(
+                positions.size()) };
+            world.insert<position>(entities, positions);
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_Emplace(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            world world;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                world.emplace<position>(world.create(), 1.0F, 2.0F);
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_Erase(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            state.PauseTiming();
+            world world;
+            std::vector<entity> entities;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                entities.push_back(world.create());
+                world.insert(entities.back(), position {});
+            }
+            state.ResumeTiming();
+
+            for (const entity entity : entities) {
+                world.erase<position>(entity);
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_Destroy(::benchmark::State& state)
+    {
+        for (auto _ : state) {
+            state.PauseTiming();
+            world world;
+            std::vector<entity> entities;
+            for (int64_t i { 0 }; i < state.range(0); ++i) {
+                entities.push_back(world.create());
+                world.insert(entities.back(), position {});
+                world.insert(entities.back(), velocity {});
+            }
+            state.ResumeTiming();
+
+            for (const entity entity : entities) {
+                world.destroy(entity);
+            }
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_ViewOne(::benchmark::State& state)
+    {
+        world world;
+        populate(world, state.range(0), 0);
+
+        for (auto _ : state) {
+            world.view<position>([](const entity /*unused*/, position& pos) {
+                pos.x += 1.0F;
+            });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_ViewTwo(::benchmark::State& state)
+    {
+        world world;
+        populate(world, state.range(0), state.range(1));
+
+        for (auto _ : state) {
+            world.view<position, velocity>(
+                [](const entity /*unused*/, position& pos,
+                    const velocity& vel) {
+                    pos.x += vel.dx;
+                    pos.y += vel.dy;
+                });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_ViewExclude(::benchmark::State& state)
+    {
+        world world;
+        populate(world, state.range(0), state.range(1));
+
+        for (auto _ : state) {
+            world.view<position, exclude<velocity>>(
+                [](const entity /*unused*/, position& pos) { pos.x += 1.0; });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_GroupTwo(::benchmark::State& state)
+    {
+        world world;
+        const auto group { world.group<position, velocity>() };
+        populate(world, state.range(0), state.range(1));
+
+        for (auto _ : state) {
+            group.each([](const entity /*unused*/, position& pos,
+                           const velocity& vel) {
+                pos.x += vel.dx;
+                pos.y += vel.dy;
+            });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_QueryTwo(::benchmark::State& state)
+    {
+        world world;
+        const auto query { world.query<position, const velocity>() };
+        populate(world, state.range(0), state.range(1));
+
+        for (auto _ : state) {
+            query.each([](const entity /*unused*/, position& pos,
+                           const velocity& vel) {
+                pos.x += vel.dx;
+                pos.y += vel.dy;
+            });
+            ::benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_World_Resource(::benchmark::State& state)
+    {
+        world world;
+        world.emplace<settings>();
+
+        for (auto _ : state) {
+            ::benchmark::DoNotOptimize(world.resource<settings>());
+        }
+    }
+
+    void BM_World_Components(::benchmark::State& state)
+    {
+        world world;
+        static_cast<void>(world.components<position>());
+
+        for (auto _ : state) {
+            ::benchmark::DoNotOptimize(world.components<position>());
+        }
+    }
+
+    void view_ranges(::benchmark::internal::Benchmark* benchmark)
+    {
+        for (const int64_t count : { 10'000, 100'000, 1'000'000 }) {
+            for (const int64_t overlap : { 1, 10, 50, 100 }) {
+                benchmark->Args({ count, overlap });
+            }
+        }
+    }
+
+} // namespace
+
+BENCHMARK(BM_World_Create)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_CreateMany)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_Insert)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_InsertMany)
+    ->RangeMultiplier(10)
+    ->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_Emplace)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_Erase)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_Destroy)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_ViewOne)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_World_ViewTwo)->Apply(view_ranges);
+BENCHMARK(BM_World_ViewExclude)->Apply(view_ranges);
+BENCHMARK(BM_World_GroupTwo)->Apply(view_ranges);
+BENCHMARK(BM_World_QueryTwo)->Apply(view_ranges);
+BENCHMARK(BM_World_Resource);
+BENCHMARK(BM_World_Components);
+
+} // namespace eecs::benchmark
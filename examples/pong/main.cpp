@@ -2,6 +2,7 @@
 
 #include "app.hpp"
 #include "input.hpp"
+#include "system_param.hpp"
 #include "world.hpp"
 
 namespace {
@@ -13,19 +14,18 @@ struct vec2 {
 
 void startup(eecs::world& world) { std::println("startup"); }
 
-void update(eecs::world& world)
+void update(eecs::res<const eecs::input> input)
 {
-    auto& input = world.resource<eecs::input>();
-    if (input.is_key_pressed(eecs::key::up)) {
+    if (input->is_key_pressed(eecs::key::up)) {
         std::println("up key is pressed");
     }
-    if (input.is_key_pressed(eecs::key::down)) {
+    if (input->is_key_pressed(eecs::key::down)) {
         std::println("down key is pressed");
     }
-    if (input.is_key_pressed(eecs::key::left)) {
+    if (input->is_key_pressed(eecs::key::left)) {
         std::println("left key is pressed");
     }
-    if (input.is_key_pressed(eecs::key::right)) {
+    if (input->is_key_pressed(eecs::key::right)) {
         std::println("right key is pressed");
     }
 }
@@ -40,5 +40,6 @@ int main()
     app.add_system(eecs::event::startup, startup)
         .add_system(eecs::event::update, update)
         .add_system(eecs::event::shutdown, shutdown)
+        .set_frame_limit(60)
         .run();
 }
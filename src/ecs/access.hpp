@@ -0,0 +1,151 @@
+#ifndef EECS_ACCESS_HPP
+#define EECS_ACCESS_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "family.hpp"
+#include "types.hpp"
+#include "world.hpp"
+
+namespace eecs {
+
+/// Declares that a system reads components of the given types.
+template <typename... T>
+struct reads { };
+
+/// Declares that a system reads and writes components of the given types.
+template <typename... T>
+struct writes { };
+
+/// Declares that a system reads resources of the given types.
+template <typename... T>
+struct reads_resource { };
+
+/// Declares that a system reads and writes resources of the given types.
+template <typename... T>
+struct writes_resource { };
+
+/// The components and resources that a system reads and writes.
+///
+/// Systems whose accesses do not conflict may run concurrently. An access
+/// that declares nothing is exclusive: it conflicts with every other access,
+/// which is required for systems that make structural changes such as
+/// creating or destroying entities, or that insert components whose types
+/// were not declared.
+class access {
+public:
+    /// Constructs an exclusive `::access`.
+    access() = default;
+
+    /// Constructs an `::access` from a list of declarations.
+    ///
+    /// \tparam Declarations The `::reads`, `::writes`, `::reads_resource` and
+    ///     `::writes_resource` declarations.
+    /// \return The declared `::access`.
+    template <typename... Declarations>
+    [[nodiscard]] static access of()
+    {
+        access result;
+        result.m_exclusive = sizeof...(Declarations) == 0;
+        (result.declare(Declarations {}), ...);
+        return result;
+    }
+
+    /// Checks whether this `::access` is exclusive.
+    ///
+    /// \return Whether this `::access` is exclusive.
+    [[nodiscard]] bool exclusive() const noexcept { return m_exclusive; }
+
+    /// Checks whether this `::access` conflicts with another, i.e., whether
+    /// the systems declaring them must not run concurrently.
+    ///
+    /// \param other The other `::access`.
+    /// \return `true` if the accesses conflict; `false` otherwise.
+    [[nodiscard]] bool conflicts_with(const access& other) const noexcept
+    {
+        if (m_exclusive || other.m_exclusive) {
+            return true;
+        }
+
+        const auto overlaps = [](const std::vector<u32>& lhs,
+                                  const std::vector<u32>& rhs) {
+            return std::ranges::any_of(lhs, [&rhs](const u32 key) {
+                return std::ranges::find(rhs, key) != rhs.end();
+            });
+        };
+
+        return overlaps(m_writes, other.m_writes)
+            || overlaps(m_writes, other.m_reads)
+            || overlaps(m_reads, other.m_writes);
+    }
+
+    /// Creates the component collections of every declared type of
+    /// component, so that systems running concurrently never need to. The
+    /// collections declared as written are also copied if `world::freeze()`
+    /// shares them, while those only read stay shared.
+    ///
+    /// \param world The `::world` to create the collections in.
+    void prepare(world& world) const
+    {
+        for (const auto prepare : m_prepare) {
+            prepare(world);
+        }
+    }
+
+private:
+    using key_family = family<struct access_tag>;
+
+    template <typename T>
+    struct component_key { };
+
+    template <typename T>
+    struct resource_key { };
+
+    template <typename... T>
+    void declare(reads<T...> /*unused*/)
+    {
+        (m_reads.push_back(key_family::id<component_key<T>>()), ...);
+        (m_prepare.push_back(&access::prepare_reads<T>), ...);
+    }
+
+    template <typename... T>
+    void declare(writes<T...> /*unused*/)
+    {
+        (m_writes.push_back(key_family::id<component_key<T>>()), ...);
+        (m_prepare.push_back(&access::prepare_writes<T>), ...);
+    }
+
+    template <typename... T>
+    void declare(reads_resource<T...> /*unused*/)
+    {
+        (m_reads.push_back(key_family::id<resource_key<T>>()), ...);
+    }
+
+    template <typename... T>
+    void declare(writes_resource<T...> /*unused*/)
+    {
+        (m_writes.push_back(key_family::id<resource_key<T>>()), ...);
+    }
+
+    template <typename T>
+    static void prepare_reads(world& world)
+    {
+        static_cast<void>(world.slot<T>());
+    }
+
+    template <typename T>
+    static void prepare_writes(world& world)
+    {
+        static_cast<void>(world.components<T>());
+    }
+
+    std::vector<u32> m_reads;
+    std::vector<u32> m_writes;
+    std::vector<void (*)(world&)> m_prepare;
+    bool m_exclusive { true };
+};
+
+} // namespace eecs
+
+#endif // !EECS_ACCESS_HPP
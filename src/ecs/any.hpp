@@ -2,19 +2,42 @@
 #define EECS_ANY_HPP
 
 #include <any>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <format>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <typeindex>
+#include <typeinfo>
 #include <utility>
 
 namespace eecs {
 
 /// A type-safe container for single values of any type.
+///
+/// Small objects that are nothrow move constructible are stored inline,
+/// without a heap allocation. Larger objects are stored on the heap, so their
+/// addresses remain stable when the `::any` itself is moved.
 class any {
 public:
+    /// The size, in bytes, of the inline storage buffer.
+    static constexpr std::size_t inline_size { 3 * sizeof(void*) };
+
+    /// The alignment, in bytes, of the inline storage buffer.
+    static constexpr std::size_t inline_align { alignof(void*) };
+
+    /// Whether an object of type `T` is stored inline rather than on the
+    /// heap.
+    ///
+    /// \tparam T The type of the object.
+    template <typename T>
+    static constexpr bool stores_inline { sizeof(T) <= inline_size
+        && alignof(T) <= inline_align
+        && std::is_nothrow_move_constructible_v<T> };
+
     /// Constructs an empty `::any`.
     any() noexcept = default;
 
@@ -24,17 +47,15 @@ public:
     any(const any& other)
     {
         if (other.has_value()) {
-            m_pimpl = other.m_pimpl->clone();
-            m_type_index = other.m_type_index;
+            other.m_vtable->copy(other, *this);
         }
     }
 
     /// Constructs an `::any` by moving the contents of another `::any` into
     /// this one.
     ///
-    /// \param other The object to move from. Left in a valid but unspecified
-    ///     state.
-    any(any&& other) noexcept = default;
+    /// \param other The object to move from. Left empty.
+    any(any&& other) noexcept { take(other); }
 
     /// Constructs an `::any` holding an object of type `ValueType`,
     /// constructed in place.
@@ -44,10 +65,8 @@ public:
     /// \param args Arguments forwarded to the constructor of the held object.
     template <typename ValueType, typename... Args>
     explicit any(std::in_place_type_t<ValueType> /*unused*/, Args&&... args)
-        : m_pimpl(
-              std::make_unique<holder<ValueType>>(std::forward<Args>(args)...))
-        , m_type_index(std::type_index(typeid(ValueType)))
     {
+        construct<ValueType>(std::forward<Args>(args)...);
     }
 
     /// Constructs an `::any` holding an object of type `ValueType`,
@@ -59,10 +78,8 @@ public:
     template <typename ValueType>
     explicit any(ValueType&& value)
         requires(!std::is_same_v<std::decay_t<ValueType>, any>)
-        : m_pimpl(std::make_unique<holder<ValueType>>(
-              std::forward<ValueType>(value)))
-        , m_type_index(std::type_index(typeid(ValueType)))
     {
+        construct<std::decay_t<ValueType>>(std::forward<ValueType>(value));
     }
 
     /// Copies the contents of another `::any` into this one.
@@ -72,13 +89,9 @@ public:
     any& operator=(const any& other)
     {
         if (&other != this) {
-            if (other.has_value()) {
-                m_pimpl = other.m_pimpl->clone();
-                m_type_index = other.m_type_index;
-            } else {
-                m_pimpl.reset();
-                m_type_index = std::type_index(typeid(void));
-            }
+            any copy { other };
+            reset();
+            take(copy);
         }
 
         return *this;
@@ -86,15 +99,22 @@ public:
 
     /// Moves the contents of another `::any` into this one.
     ///
-    /// \param other The object to move from. Left in a valid but unspecified
-    ///     state.
+    /// \param other The object to move from. Left empty.
     /// \return A reference to this object.
-    any& operator=(any&& other) noexcept = default;
+    any& operator=(any&& other) noexcept
+    {
+        if (&other != this) {
+            reset();
+            take(other);
+        }
+
+        return *this;
+    }
 
     /// Destroys an `::any` and its held object, if one exists.
-    ~any() = default;
+    ~any() { reset(); }
 
-    bool operator==(const any& other) const noexcept
+    bool operator==(const any& other) const
     {
         if (has_value() != other.has_value()) {
             return false;
@@ -105,79 +125,153 @@ public:
         if (!has_value() && !other.has_value()) {
             return true;
         }
-        return m_pimpl->equals(*other.m_pimpl);
+        return m_vtable->equals(*this, other);
     }
 
     /// Checks whether this `::any` object is holding an object.
     ///
     /// \return Whether this object is empty.
-    [[nodiscard]] bool has_value() const noexcept { return m_pimpl != nullptr; }
+    [[nodiscard]] bool has_value() const noexcept
+    {
+        return m_vtable != nullptr;
+    }
 
     /// Returns the type index of the object held by this `::any`.
     ///
     /// \return The type index of the held object.
-    [[nodiscard]] std::type_index type() const noexcept { return m_type_index; }
+    [[nodiscard]] std::type_index type() const noexcept
+    {
+        return has_value() ? std::type_index(*m_vtable->type)
+                           : std::type_index(typeid(void));
+    }
+
+    /// Destroys the held object, if one exists, leaving this `::any` empty.
+    void reset() noexcept
+    {
+        if (has_value()) {
+            m_vtable->destroy(*this);
+            m_vtable = nullptr;
+        }
+    }
 
 private:
-    /// An abstract base class which provides the polymorphic interface for type
-    /// erasure.
-    struct placeholder {
-        placeholder() noexcept = default;
-        placeholder(const placeholder& other) = default;
-        placeholder(placeholder&& other) noexcept = default;
-        placeholder& operator=(const placeholder& other) = default;
-        placeholder& operator=(placeholder&& other) noexcept = default;
-        virtual ~placeholder() = default;
-
-        [[nodiscard]] virtual std::unique_ptr<placeholder> clone() const = 0;
-        [[nodiscard]] virtual bool equals(const placeholder& other) const = 0;
+    /// A manual table of the operations on a held object.
+    struct vtable {
+        const std::type_info* type;
+        void (*destroy)(any& self) noexcept;
+        void (*copy)(const any& from, any& to);
+        void (*move)(any& from, any& to) noexcept;
+        bool (*equals)(const any& lhs, const any& rhs);
+    };
+
+    /// The storage of a held object: either inline or a pointer to the heap.
+    union storage {
+        alignas(inline_align) std::byte buffer[inline_size];
+        void* heap;
     };
 
-    /// A simple container for an object of type `T`.
+    /// Returns a pointer to the held object of type `T`.
+    template <typename T>
+    [[nodiscard]] T* get() noexcept
+    {
+        if constexpr (stores_inline<T>) {
+            return std::launder(reinterpret_cast<T*>(m_storage.buffer));
+        } else {
+            return static_cast<T*>(m_storage.heap);
+        }
+    }
+
+    /// Returns a pointer to the constant held object of type `T`.
+    template <typename T>
+    [[nodiscard]] const T* get() const noexcept
+    {
+        return const_cast<any*>(this)->get<T>();
+    }
+
+    /// Constructs a held object of type `T` in place. This `::any` must be
+    /// empty.
+    template <typename T, typename... Args>
+    void construct(Args&&... args)
+    {
+        if constexpr (stores_inline<T>) {
+            ::new (static_cast<void*>(m_storage.buffer))
+                T(std::forward<Args>(args)...);
+        } else {
+            m_storage.heap = new T(std::forward<Args>(args)...);
+        }
+
+        m_vtable = &s_vtable<T>;
+    }
+
+    /// Moves the held object of another `::any` into this empty one, leaving
+    /// the other one empty.
+    void take(any& other) noexcept
+    {
+        if (other.has_value()) {
+            other.m_vtable->move(other, *this);
+            m_vtable = std::exchange(other.m_vtable, nullptr);
+        }
+    }
+
     template <typename T>
-    struct holder final : placeholder {
-        /// Constructs a `::holder` containing an object of type `T`,
-        /// constructed in place.
-        ///
-        /// \tparam Args The types of arguments to forward.
-        /// \param args Arguments forwarded to the constructor of the held
-        ///     object.
-        template <typename... Args>
-        explicit holder(Args&&... args)
-            : data(std::forward<Args>(args)...)
-        {
+    static void destroy(any& self) noexcept
+    {
+        if constexpr (stores_inline<T>) {
+            std::destroy_at(self.get<T>());
+        } else {
+            delete self.get<T>();
+        }
+    }
+
+    /// Copies a held object if it is copy constructible.
+    ///
+    /// \throw `std::logic_error` if the held object is not copy
+    ///     constructible.
+    template <typename T>
+    static void copy(const any& from, any& to)
+    {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            to.construct<T>(*from.get<T>());
+        } else {
+            throw std::logic_error(std::format(
+                "Type {} is not copy constructible", typeid(T).name()));
         }
+    }
 
-        /// Copies a `::holder` if the held object is copy constructible.
-        ///
-        /// \return A copy of this object.
-        /// \throw `std::logic_error` if the held object is not copy
-        ///     constructible.
-        [[nodiscard]] std::unique_ptr<placeholder> clone() const override
-        {
-            if constexpr (std::is_copy_constructible_v<T>) {
-                return std::make_unique<holder<T>>(data);
-            } else {
-                throw std::logic_error(std::format(
-                    "Type {} is not copy constructible", typeid(T).name()));
-            }
+    template <typename T>
+    static void move(any& from, any& to) noexcept
+    {
+        if constexpr (stores_inline<T>) {
+            ::new (static_cast<void*>(to.m_storage.buffer))
+                T(std::move(*from.get<T>()));
+            std::destroy_at(from.get<T>());
+        } else {
+            to.m_storage.heap = from.m_storage.heap;
         }
+    }
 
-        [[nodiscard]] bool equals(const placeholder& other) const override
-        {
-            if constexpr (std::equality_comparable<T>) {
-                return data == static_cast<const holder<T>&>(other).data;
-            } else {
-                throw std::logic_error(std::format(
-                    "Type {} is not equality comparable", typeid(T).name()));
-            }
+    template <typename T>
+    static bool equals(const any& lhs, const any& rhs)
+    {
+        if constexpr (std::equality_comparable<T>) {
+            return *lhs.get<T>() == *rhs.get<T>();
+        } else {
+            throw std::logic_error(std::format(
+                "Type {} is not equality comparable", typeid(T).name()));
         }
+    }
 
-        T data;
+    template <typename T>
+    static constexpr vtable s_vtable {
+        .type = &typeid(T),
+        .destroy = &any::destroy<T>,
+        .copy = &any::copy<T>,
+        .move = &any::move<T>,
+        .equals = &any::equals<T>,
     };
 
-    std::unique_ptr<placeholder> m_pimpl;
-    std::type_index m_type_index { std::type_index(typeid(void)) };
+    storage m_storage {};
+    const vtable* m_vtable { nullptr };
 
     /// Casts an `::any` to a reference of its held object.
     ///
@@ -194,6 +288,16 @@ private:
     /// \return A constant reference to the held object.
     template <typename T>
     friend const T& any_cast(const any& operand);
+
+    /// Casts an `::any` to a reference of its held object without checking
+    /// the type of the held object.
+    ///
+    /// \tparam T The type of the held object.
+    /// \param operand The object to cast from. Must hold an object of type
+    ///     `T`.
+    /// \return A reference to the held object.
+    template <typename T>
+    friend T& unchecked_any_cast(any& operand) noexcept;
 };
 
 template <typename T>
@@ -202,8 +306,7 @@ T& any_cast(any& operand)
     if (operand.type() != std::type_index(typeid(T))) {
         throw std::bad_any_cast();
     }
-    auto* holder = static_cast<any::holder<T>*>(operand.m_pimpl.get());
-    return holder->data;
+    return *operand.get<T>();
 }
 
 template <typename T>
@@ -212,9 +315,14 @@ const T& any_cast(const any& operand)
     if (operand.type() != std::type_index(typeid(T))) {
         throw std::bad_any_cast();
     }
-    const auto* holder
-        = static_cast<const any::holder<T>*>(operand.m_pimpl.get());
-    return holder->data;
+    return *operand.get<T>();
+}
+
+template <typename T>
+T& unchecked_any_cast(any& operand) noexcept
+{
+    assert(operand.type() == std::type_index(typeid(T)));
+    return *operand.get<T>();
 }
 
 } // namespace eecs
@@ -1,42 +1,212 @@
 #include "app.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <utility>
 
+#include "command_buffer.hpp"
 #include "input.hpp"
+#include "profiler.hpp"
+#include "time.hpp"
+#include "types.hpp"
 #include "window.hpp"
 
-#include "SDL3/SDL_events.h"
 #include "SDL3/SDL_init.h"
 
 namespace eecs {
 
-app& app::add_system(event event, system system)
+app& app::add_system(
+    const event event, system system, const std::string_view name)
 {
-    m_schedules[std::to_underlying(event)].add_system(system);
+    m_schedules[std::to_underlying(event)].add_system(std::move(system), name);
     return *this;
 }
 
+app& app::set_fixed_timestep(const time::duration step, const u32 max_steps)
+{
+    if (step <= time::duration::zero() || max_steps == 0) {
+        throw std::invalid_argument("Invalid fixed timestep");
+    }
+
+    m_fixed_step = step;
+    m_max_fixed_steps = max_steps;
+    return *this;
+}
+
+app& app::set_frame_limit(const u32 frames_per_second)
+{
+    m_frame_period = frames_per_second == 0
+        ? time::duration::zero()
+        : std::chrono::duration_cast<time::duration>(
+              std::chrono::seconds { 1 })
+            / frames_per_second;
+    return *this;
+}
+
+app& app::set_headless(const bool headless)
+{
+    m_headless = headless;
+    return *this;
+}
+
+app& app::set_thread_count(const std::size_t count)
+{
+    m_thread_count = count;
+    return *this;
+}
+
+std::size_t app::thread_count() const noexcept
+{
+    return m_pool != nullptr ? m_pool->size() : 0;
+}
+
 void app::run()
 {
-    SDL_Init(SDL_INIT_VIDEO);
+    start();
 
-    const int width { 800 };
-    const int height { 600 };
-    m_world.emplace<window>("title", width, height);
-    m_world.emplace<input>();
-    auto& myinput = m_world.resource<input>();
+    while (!exit_requested()) {
+        paced_frame();
+    }
+
+    stop();
+}
 
-    m_schedules[std::to_underlying(event::startup)].run(m_world);
+void app::run_for(const u64 frames)
+{
+    if (!m_running) {
+        start();
+    }
 
-    SDL_Event event;
-    while (!myinput.quit()) {
-        myinput.poll();
-        m_schedules[std::to_underlying(event::update)].run(m_world);
+    for (u64 i { 0 }; i < frames && !exit_requested(); ++i) {
+        paced_frame();
     }
+}
 
-    m_schedules[std::to_underlying(event::shutdown)].run(m_world);
+void app::step()
+{
+    if (!m_running) {
+        start();
+    }
 
-    SDL_Quit();
+    frame(clock::now());
+}
+
+void app::step(const time::duration delta)
+{
+    if (!m_running) {
+        start();
+    }
+
+    frame(m_last_frame + delta);
+}
+
+void app::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    run_schedule(event::shutdown);
+    m_running = false;
+
+    if (!m_headless) {
+        SDL_Quit();
+    }
+}
+
+void app::start()
+{
+    if (!m_headless) {
+        SDL_Init(SDL_INIT_VIDEO);
+
+        const int width { 800 };
+        const int height { 600 };
+        m_world.emplace<window>("title", width, height);
+        m_world.emplace<input>();
+    }
+    m_world.emplace<command_buffer>();
+    m_world.emplace<time>(time { .fixed_delta = m_fixed_step });
+    m_world.emplace<app_exit>();
+
+    const std::size_t thread_count { m_thread_count.value_or(
+        m_headless ? 0 : std::thread::hardware_concurrency()) };
+    if (m_pool == nullptr && thread_count > 0) {
+        m_pool = std::make_unique<thread_pool>(thread_count);
+    }
+
+    run_schedule(event::startup);
+
+    m_accumulator = time::duration::zero();
+    m_last_frame = clock::now();
+    m_running = true;
+}
+
+void app::run_schedule(const event event)
+{
+    const schedule& schedule { m_schedules[std::to_underlying(event)] };
+
+    if (m_pool != nullptr) {
+        schedule.run(m_world, *m_pool);
+    } else {
+        schedule.run(m_world);
+    }
+}
+
+bool app::exit_requested()
+{
+    const auto* input { m_world.try_resource<eecs::input>() };
+    return m_world.resource<app_exit>().requested
+        || (input != nullptr && input->quit());
+}
+
+void app::paced_frame()
+{
+    const clock::time_point start { clock::now() };
+    frame(start);
+
+    if (m_frame_period > time::duration::zero()) {
+        std::this_thread::sleep_until(start + m_frame_period);
+    }
+}
+
+void app::frame(const clock::time_point now)
+{
+    if (auto* input { m_world.try_resource<eecs::input>() }) {
+        input->poll();
+    }
+
+    auto& time { m_world.resource<eecs::time>() };
+    time.delta = now - m_last_frame;
+    time.elapsed += time.delta;
+    time.fixed_delta = m_fixed_step;
+    ++time.frame;
+    m_last_frame = now;
+
+    auto* profiler { m_world.try_resource<eecs::profiler>() };
+    if (profiler != nullptr) {
+        profiler->begin_frame(time.frame);
+    }
+
+    m_accumulator += time.delta;
+    for (u32 step { 0 };
+        m_accumulator >= m_fixed_step && step < m_max_fixed_steps; ++step) {
+        run_schedule(event::fixed_update);
+        m_accumulator -= m_fixed_step;
+    }
+    m_accumulator %= m_fixed_step;
+    time.overstep = std::chrono::duration<double> { m_accumulator }
+        / m_fixed_step;
+
+    run_schedule(event::update);
+
+    if (profiler != nullptr) {
+        profiler->end_frame(m_world.size());
+    }
+    m_world.advance_tick();
 }
 
 } // namespace eecs
@@ -2,31 +2,177 @@
 #define EECS_APP_HPP
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "schedule.hpp"
 #include "system.hpp"
+#include "thread_pool.hpp"
+#include "time.hpp"
+#include "types.hpp"
+#include "world.hpp"
 
 namespace eecs {
 
 enum class event : uint8_t {
     startup,
+    fixed_update, // Runs zero or more times per frame, before update.
     update,
     shutdown,
     count, // Represents the number of event enums.
 };
 
+/// A resource that systems set to stop `app::run()` and `app::run_for()`
+/// once the current frame ends.
+struct app_exit {
+    bool requested { false };
+};
+
 class app {
 public:
-    /// Adds a system to run on a given event.
-    app& add_system(event event, system system);
+    using clock = std::chrono::steady_clock;
+
+    /// Adds a system to run on a given event, optionally named for the
+    /// `::profiler`.
+    app& add_system(event event, system system, std::string_view name = {});
+
+    /// Adds a system that accesses the given components and resources to run
+    /// on a given event. Systems that do not conflict may run concurrently.
+    ///
+    /// \tparam Declarations The `::reads`, `::writes`, `::reads_resource` and
+    ///     `::writes_resource` declarations of the system.
+    template <typename... Declarations>
+    app& add_system(
+        const event event, system system, const std::string_view name = {})
+    {
+        m_schedules[static_cast<size_t>(event)]
+            .add_system<Declarations...>(std::move(system), name);
+        return *this;
+    }
+
+    /// Adds a system whose parameters are resolved from the `::world` to run
+    /// on a given event, see `schedule::add_system()`.
+    template <typename Fn>
+        requires(!std::is_invocable_v<Fn&, eecs::world&>)
+    app& add_system(
+        const event event, Fn fn, const std::string_view name = {})
+    {
+        m_schedules[static_cast<size_t>(event)].add_system(std::move(fn), name);
+        return *this;
+    }
+
+    /// Sets the time step of `event::fixed_update`, which runs as many times
+    /// per frame as needed for the simulated time to keep up with the
+    /// elapsed time. Defaults to 1/60 s and 8 steps.
+    ///
+    /// \param step The time simulated by each fixed update.
+    /// \param max_steps The maximum number of fixed updates per frame. Time
+    ///     left over beyond them is dropped, so that a slow frame does not
+    ///     make the following ones slower still.
+    /// \return A reference to this object.
+    /// \throws std::invalid_argument if `step` is not positive or
+    ///     `max_steps` is zero.
+    app& set_fixed_timestep(time::duration step, u32 max_steps = 8);
+
+    /// Limits the rate of frames by sleeping out the rest of each frame.
+    ///
+    /// \param frames_per_second The maximum number of frames per second, or
+    ///     zero not to limit it, which is the default.
+    /// \return A reference to this object.
+    app& set_frame_limit(u32 frames_per_second);
+
+    /// Runs the app without a window or input, e.g., on servers or in tests.
+    /// Video is then never initialized. Must be set before the app starts.
+    ///
+    /// \param headless Whether to run without a window.
+    /// \return A reference to this object.
+    app& set_headless(bool headless = true);
+
+    /// Sets the number of worker threads that systems run on. With none,
+    /// systems run one after the other on the thread running the app.
+    /// Defaults to one per hardware thread, or to none for a headless app,
+    /// so that many headless instances start quickly and leave the cores to
+    /// each other. Must be set before the app starts.
+    ///
+    /// \param count The number of worker threads.
+    /// \return A reference to this object.
+    app& set_thread_count(std::size_t count);
+
+    /// Returns the number of worker threads that systems run on, once the
+    /// app has started.
+    ///
+    /// \return The number of worker threads.
+    [[nodiscard]] std::size_t thread_count() const noexcept;
 
-    /// Runs the app.
+    /// Returns the `::world` of the app, e.g., to insert resources before it
+    /// starts or inspect it between steps.
+    ///
+    /// \return A reference to the `::world`.
+    [[nodiscard]] eecs::world& world() noexcept { return m_world; }
+
+    /// Runs the app until the window is closed or `::app_exit` is requested,
+    /// then stops it.
     void run();
 
+    /// Runs `frames` frames of the app, or fewer if `::app_exit` is
+    /// requested, starting it first if needed. Frames are paced by the frame
+    /// limit. The app is left running.
+    ///
+    /// \param frames The number of frames to run.
+    void run_for(u64 frames);
+
+    /// Runs a single frame of the app, starting it first if needed.
+    void step();
+
+    /// Runs a single frame of the app as if `delta` had passed since the
+    /// previous one, starting it first if needed. Stepping only this way
+    /// makes the fixed updates independent of the wall clock.
+    ///
+    /// \param delta The simulated time since the previous frame.
+    void step(time::duration delta);
+
+    /// Runs the shutdown systems of the app if it is running.
+    void stop();
+
 private:
-    world m_world;
+    /// Inserts the app's resources and runs the startup systems.
+    void start();
+
+    /// Runs the schedule of an event, on the worker threads if there are
+    /// any.
+    void run_schedule(event event);
+
+    /// Checks whether the window was closed or `::app_exit` was requested.
+    [[nodiscard]] bool exit_requested();
+
+    /// Runs a frame starting now, then sleeps out the rest of the frame
+    /// period, if any.
+    void paced_frame();
+
+    /// Polls input, updates the `::time` resource and runs the fixed update
+    /// and update schedules for a frame starting at `now`, marking the frame
+    /// in the `::profiler` resource, if there is one.
+    void frame(clock::time_point now);
+
+    eecs::world m_world;
+    // Created when the app starts, only if it has worker threads.
+    std::unique_ptr<thread_pool> m_pool;
+    std::optional<std::size_t> m_thread_count;
     std::array<schedule, static_cast<size_t>(event::count)> m_schedules = {};
+    time::duration m_fixed_step { time::duration { std::chrono::seconds { 1 } }
+        / 60 };
+    u32 m_max_fixed_steps { 8 };
+    time::duration m_frame_period {};
+    time::duration m_accumulator {};
+    clock::time_point m_last_frame;
+    bool m_headless { false };
+    bool m_running { false };
 };
 
 } // namespace eecs
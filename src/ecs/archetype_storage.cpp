@@ -0,0 +1,277 @@
+#include "archetype_storage.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "types.hpp"
+
+namespace eecs {
+
+namespace {
+
+    /// Rounds `offset` up to a multiple of `alignment`.
+    constexpr std::size_t align_up(
+        const std::size_t offset, const std::size_t alignment) noexcept
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+} // namespace
+
+void archetype_storage::remove(const entity entity) noexcept
+{
+    const location* location { locate(entity) };
+    if (location == nullptr) {
+        return;
+    }
+
+    archetype& archetype { m_archetypes[location->archetype] };
+    const std::size_t row { location->row };
+
+    for (std::size_t column { 0 }; column < archetype.signature.size();
+        ++column) {
+        m_components[archetype.signature[column]].destroy(
+            element(archetype, column, row));
+    }
+
+    m_locations[traits::to_index(entity)] = {};
+    fill_hole(archetype, row);
+}
+
+void archetype_storage::clear() noexcept
+{
+    for (archetype& archetype : m_archetypes) {
+        for (std::size_t row { 0 }; row < archetype.size; ++row) {
+            for (std::size_t column { 0 }; column < archetype.signature.size();
+                ++column) {
+                m_components[archetype.signature[column]].destroy(
+                    element(archetype, column, row));
+            }
+        }
+
+        archetype.size = 0;
+    }
+
+    m_locations.clear();
+}
+
+std::size_t archetype_storage::column(
+    const archetype& archetype, const u32 component) noexcept
+{
+    const auto it { std::ranges::lower_bound(archetype.signature, component) };
+
+    if (it == archetype.signature.end() || *it != component) {
+        return s_npos;
+    }
+
+    return static_cast<std::size_t>(it - archetype.signature.begin());
+}
+
+void* archetype_storage::element(const archetype& archetype,
+    const std::size_t column, const std::size_t row) const noexcept
+{
+    std::byte* data { archetype.chunks[row / archetype.capacity].get() };
+    const std::size_t size { m_components[archetype.signature[column]].size };
+    return data + archetype.offsets[column] + (row % archetype.capacity) * size;
+}
+
+entity* archetype_storage::id_at(
+    const archetype& archetype, const std::size_t row) noexcept
+{
+    std::byte* data { archetype.chunks[row / archetype.capacity].get() };
+    return reinterpret_cast<entity*>(data) + row % archetype.capacity;
+}
+
+const archetype_storage::location* archetype_storage::locate(
+    const entity entity) const noexcept
+{
+    const auto index { traits::to_index(entity) };
+    if (index >= m_locations.size()) {
+        return nullptr;
+    }
+
+    const location& location { m_locations[index] };
+    if (location.archetype == s_none) {
+        return nullptr;
+    }
+
+    return *id_at(m_archetypes[location.archetype], location.row) == entity
+        ? &location
+        : nullptr;
+}
+
+u32 archetype_storage::archetype_of(std::vector<u32> signature)
+{
+    if (const auto it { m_signatures.find(signature) };
+        it != m_signatures.end()) {
+        return it->second;
+    }
+
+    archetype archetype;
+    archetype.signature = std::move(signature);
+
+    std::size_t row_size { sizeof(entity) };
+    for (const u32 component : archetype.signature) {
+        row_size += m_components[component].size;
+    }
+
+    // Padding between columns can push a chunk over its size, in which case
+    // it holds fewer rows.
+    archetype.capacity = std::max<std::size_t>(chunk_size / row_size, 1);
+    while (true) {
+        std::size_t offset { sizeof(entity) * archetype.capacity };
+        archetype.offsets.clear();
+
+        for (const u32 component : archetype.signature) {
+            const component_info& info { m_components[component] };
+            offset = align_up(offset, info.alignment);
+            archetype.offsets.push_back(offset);
+            offset += info.size * archetype.capacity;
+        }
+
+        if (offset <= chunk_size || archetype.capacity == 1) {
+            archetype.chunk_bytes = align_up(offset, chunk_alignment);
+            break;
+        }
+
+        --archetype.capacity;
+    }
+
+    const auto id { static_cast<u32>(m_archetypes.size()) };
+    m_signatures.emplace(archetype.signature, id);
+    m_archetypes.push_back(std::move(archetype));
+    return id;
+}
+
+u32 archetype_storage::root(const u32 component)
+{
+    if (m_components[component].root == s_none) {
+        m_components[component].root
+            = archetype_of(std::vector<u32> { component });
+    }
+
+    return m_components[component].root;
+}
+
+u32 archetype_storage::neighbour(
+    const u32 archetype, const u32 component, const bool insert)
+{
+    const auto& edges { insert ? m_archetypes[archetype].insert_edges
+                               : m_archetypes[archetype].erase_edges };
+    for (const edge& edge : edges) {
+        if (edge.component == component) {
+            return edge.target;
+        }
+    }
+
+    std::vector<u32> signature { m_archetypes[archetype].signature };
+    const auto it { std::ranges::lower_bound(signature, component) };
+    if (insert) {
+        signature.insert(it, component);
+    } else {
+        signature.erase(it);
+    }
+
+    // Creating the target may relocate the archetypes, so they are indexed
+    // again afterwards.
+    const u32 target { archetype_of(std::move(signature)) };
+    (insert ? m_archetypes[archetype].insert_edges
+            : m_archetypes[archetype].erase_edges)
+        .push_back(edge { .component = component, .target = target });
+    return target;
+}
+
+void* archetype_storage::move_entity(
+    const entity entity, const u32 target, const u32 component)
+{
+    archetype& to { m_archetypes[target] };
+    const auto index { traits::to_index(entity) };
+
+    if (index >= m_locations.size()) {
+        m_locations.resize(index + 1);
+    }
+
+    if (to.size == to.chunks.size() * to.capacity) {
+        to.chunks.emplace_back(static_cast<std::byte*>(::operator new(
+            to.chunk_bytes, std::align_val_t { chunk_alignment })));
+    }
+
+    const std::size_t row { to.size++ };
+    *id_at(to, row) = entity;
+
+    location& location { m_locations[index] };
+    if (location.archetype != s_none) {
+        archetype& from { m_archetypes[location.archetype] };
+
+        for (std::size_t column { 0 }; column < from.signature.size();
+            ++column) {
+            void* source { element(from, column, location.row) };
+            const component_info& info { m_components[from.signature[column]] };
+            const std::size_t destination { archetype_storage::column(
+                to, from.signature[column]) };
+
+            if (destination == s_npos) {
+                info.destroy(source);
+            } else {
+                info.relocate(element(to, destination, row), source);
+            }
+        }
+
+        fill_hole(from, location.row);
+    }
+
+    location = { .archetype = target, .row = static_cast<u32>(row) };
+
+    return component == s_none ? nullptr
+                               : element(to, column(to, component), row);
+}
+
+void archetype_storage::fill_hole(
+    archetype& archetype, const std::size_t row) noexcept
+{
+    const std::size_t last { --archetype.size };
+    if (row == last) {
+        return;
+    }
+
+    for (std::size_t column { 0 }; column < archetype.signature.size();
+        ++column) {
+        m_components[archetype.signature[column]].relocate(
+            element(archetype, column, row), element(archetype, column, last));
+    }
+
+    *id_at(archetype, row) = *id_at(archetype, last);
+    m_locations[traits::to_index(*id_at(archetype, row))].row
+        = static_cast<u32>(row);
+}
+
+std::span<const u32> archetype_storage::matching(
+    const u32 query, const std::initializer_list<u32> components)
+{
+    if (query >= m_queries.size()) {
+        m_queries.resize(query + 1);
+    }
+
+    struct query& cache { m_queries[query] };
+    for (; cache.checked < m_archetypes.size(); ++cache.checked) {
+        const std::vector<u32>& signature {
+            m_archetypes[cache.checked].signature
+        };
+
+        if (std::ranges::all_of(components, [&signature](const u32 component) {
+                return std::ranges::binary_search(signature, component);
+            })) {
+            cache.archetypes.push_back(static_cast<u32>(cache.checked));
+        }
+    }
+
+    return cache.archetypes;
+}
+
+} // namespace eecs
@@ -0,0 +1,380 @@
+#ifndef EECS_ARCHETYPE_STORAGE_HPP
+#define EECS_ARCHETYPE_STORAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "family.hpp"
+#include "types.hpp"
+
+namespace eecs {
+
+/// A table-based alternative to storing each type of component in its own
+/// `::sparse_set`.
+///
+/// Entities associated with the same set of types of components, i.e., the
+/// same archetype, share a table. Each table is split into fixed-size chunks
+/// that hold one column per type of component, so iterating over several
+/// types of components reads each of them as a sequential stream. In
+/// exchange, inserting or erasing a component moves the `::entity` and all
+/// of its components to another table.
+///
+/// The storage does not manage the lifetimes of entities: identifiers are
+/// typically created by a `::world`, and `remove()` must be called when one
+/// is destroyed.
+class archetype_storage {
+public:
+    /// The size, in bytes, of each chunk. Chunks are larger if a single row
+    /// does not fit.
+    static constexpr std::size_t chunk_size { std::size_t { 16 } * 1024 };
+
+    /// The alignment, in bytes, of each chunk, and the maximum alignment of
+    /// a component.
+    static constexpr std::size_t chunk_alignment { 64 };
+
+    archetype_storage() = default;
+    archetype_storage(const archetype_storage& other) = delete;
+    archetype_storage(archetype_storage&& other) noexcept = delete;
+    archetype_storage& operator=(const archetype_storage& other) = delete;
+    archetype_storage& operator=(archetype_storage&& other) noexcept = delete;
+
+    /// Destroys every component.
+    ~archetype_storage() { clear(); }
+
+    /// Inserts a component and associates it with an `::entity`, overwriting
+    /// the existing one if any.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \param entity The `::entity` to associate the component with.
+    /// \param component The component to insert.
+    /// \return A reference to the inserted component.
+    template <typename T>
+    T& insert(const entity entity, const T& component)
+    {
+        return emplace<T>(entity, component);
+    }
+
+    /// Inserts a new component constructed in-place with the given `args` and
+    /// associates it with an `::entity`, overwriting the existing one if any.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \tparam Args The pack of component constructor parameter types.
+    /// \param entity The `::entity` to associate the component with.
+    /// \param args The arguments to forward to the constructor of the
+    ///     component.
+    /// \return A reference to the inserted component.
+    template <typename T, typename... Args>
+    T& emplace(const entity entity, Args&&... args)
+    {
+        if (T* component { find<T>(entity) }) {
+            *component = T(std::forward<Args>(args)...);
+            return *component;
+        }
+
+        // Constructing the component before moving the `::entity` leaves
+        // the storage untouched if the constructor throws.
+        T component(std::forward<Args>(args)...);
+        const u32 id { register_component<T>() };
+        const location* current { locate(entity) };
+        const u32 target { current == nullptr
+                ? root(id)
+                : neighbour(current->archetype, id, true) };
+
+        void* slot { move_entity(entity, target, id) };
+        return *::new (slot) T(std::move(component));
+    }
+
+    /// Removes a component (if one exists) from an `::entity`.
+    ///
+    /// \tparam T The type of component to remove.
+    /// \param entity The `::entity` to remove the component from.
+    template <typename T>
+    void erase(const entity entity)
+    {
+        if (!contains<T>(entity)) {
+            return;
+        }
+
+        const u32 current { locate(entity)->archetype };
+        if (m_archetypes[current].signature.size() == 1) {
+            remove(entity);
+            return;
+        }
+
+        const u32 id { component_family::id<T>() };
+        move_entity(entity, neighbour(current, id, false), s_none);
+    }
+
+    /// Removes every component of an `::entity`.
+    ///
+    /// \param entity The `::entity` to remove the components of.
+    void remove(entity entity) noexcept;
+
+    /// Removes every component of every `::entity`.
+    void clear() noexcept;
+
+    /// Checks whether an `::entity` is associated with a component of the
+    /// given type.
+    ///
+    /// \tparam T The type of component to check.
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the component exists; `false` otherwise.
+    template <typename T>
+    [[nodiscard]] bool contains(const entity entity) const noexcept
+    {
+        const location* location { locate(entity) };
+        return location != nullptr
+            && column(m_archetypes[location->archetype],
+                   component_family::id<T>())
+            != s_npos;
+    }
+
+    /// Returns a pointer to the component of the given type associated with
+    /// an `::entity`, if one exists.
+    ///
+    /// \tparam T The type of component to find.
+    /// \param entity The `::entity` the component is associated with.
+    /// \return A pointer to the component, or `nullptr` if there is none.
+    template <typename T>
+    [[nodiscard]] T* find(const entity entity) noexcept
+    {
+        const location* location { locate(entity) };
+        if (location == nullptr) {
+            return nullptr;
+        }
+
+        const archetype& archetype { m_archetypes[location->archetype] };
+        const std::size_t index { column(
+            archetype, component_family::id<T>()) };
+        if (index == s_npos) {
+            return nullptr;
+        }
+
+        return static_cast<T*>(element(archetype, index, location->row));
+    }
+
+    /// Invokes a function on each `::entity` associated with the given types
+    /// of components.
+    ///
+    /// The archetypes that match a set of types are cached and only newly
+    /// created archetypes are checked on later calls. The function must not
+    /// insert or erase components.
+    ///
+    /// \tparam T The types of components that each `::entity` must be
+    ///     associated with.
+    /// \tparam Fn The type of function to invoke.
+    /// \param fn The function to invoke with each matching `::entity` and
+    ///     references to its components.
+    template <typename... T, typename Fn>
+    void each(Fn&& fn)
+    {
+        static_assert(sizeof...(T) > 0, "Queries need at least one type");
+
+        const std::span<const u32> archetypes { matching(
+            query_family::id<std::tuple<T...>>(),
+            { component_family::id<T>()... }) };
+
+        for (const u32 index : archetypes) {
+            const archetype& archetype { m_archetypes[index] };
+            const std::size_t columns[] {
+                column(archetype, component_family::id<T>())...
+            };
+
+            for (std::size_t first { 0 }; first < archetype.size;
+                first += archetype.capacity) {
+                std::byte* data { archetype.chunks[first / archetype.capacity]
+                        .get() };
+                const auto* ids { reinterpret_cast<const entity*>(data) };
+                const std::size_t rows { std::min<std::size_t>(
+                    archetype.capacity, archetype.size - first) };
+
+                each_in_chunk<T...>(archetype, data, columns, ids, rows, fn,
+                    std::index_sequence_for<T...> {});
+            }
+        }
+    }
+
+    /// Returns the number of archetypes created so far.
+    ///
+    /// \return The number of archetypes.
+    [[nodiscard]] std::size_t archetype_count() const noexcept
+    {
+        return m_archetypes.size();
+    }
+
+private:
+    using component_family = family<struct archetype_component_tag>;
+    using query_family = family<struct archetype_query_tag>;
+    using traits = id_traits<entity>;
+
+    static constexpr u32 s_none { traits::null };
+    static constexpr std::size_t s_npos { static_cast<std::size_t>(-1) };
+
+    /// The type-erased operations on a type of component.
+    struct component_info {
+        std::size_t size { 0 };
+        std::size_t alignment { 0 };
+        void (*relocate)(void* target, void* source) noexcept { nullptr };
+        void (*destroy)(void* component) noexcept { nullptr };
+        u32 root { s_none };
+    };
+
+    /// Releases the memory of a chunk.
+    struct chunk_deleter {
+        void operator()(std::byte* data) const noexcept
+        {
+            ::operator delete(data, std::align_val_t { chunk_alignment });
+        }
+    };
+
+    using chunk = std::unique_ptr<std::byte[], chunk_deleter>;
+
+    /// A cached transition to the archetype that has one more or one less
+    /// type of component.
+    struct edge {
+        u32 component;
+        u32 target;
+    };
+
+    /// A table of the entities that share a set of types of components.
+    struct archetype {
+        std::vector<u32> signature;
+        std::vector<std::size_t> offsets;
+        std::size_t capacity { 0 };
+        std::size_t chunk_bytes { 0 };
+        std::size_t size { 0 };
+        std::vector<chunk> chunks;
+        std::vector<edge> insert_edges;
+        std::vector<edge> erase_edges;
+    };
+
+    /// Where the components of an `::entity` are stored.
+    struct location {
+        u32 archetype { s_none };
+        u32 row { 0 };
+    };
+
+    /// The archetypes that match a set of types of components, and the
+    /// number of archetypes checked so far.
+    struct query {
+        std::vector<u32> archetypes;
+        std::size_t checked { 0 };
+    };
+
+    template <typename T>
+    u32 register_component()
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+            "Components must be nothrow move constructible");
+        static_assert(alignof(T) <= chunk_alignment,
+            "Components must not be over-aligned");
+
+        const u32 id { component_family::id<T>() };
+
+        if (id >= m_components.size()) {
+            m_components.resize(id + 1);
+        }
+
+        if (m_components[id].size == 0) {
+            m_components[id] = component_info {
+                .size = sizeof(T),
+                .alignment = alignof(T),
+                .relocate = &archetype_storage::relocate<T>,
+                .destroy = &archetype_storage::destroy<T>,
+            };
+        }
+
+        return id;
+    }
+
+    template <typename T>
+    static void relocate(void* target, void* source) noexcept
+    {
+        ::new (target) T(std::move(*static_cast<T*>(source)));
+        std::destroy_at(static_cast<T*>(source));
+    }
+
+    template <typename T>
+    static void destroy(void* component) noexcept
+    {
+        std::destroy_at(static_cast<T*>(component));
+    }
+
+    template <typename... T, typename Fn, std::size_t... I>
+    static void each_in_chunk(const archetype& archetype, std::byte* data,
+        const std::size_t (&columns)[sizeof...(T)], const entity* ids,
+        const std::size_t rows, Fn& fn, std::index_sequence<I...> /*unused*/)
+    {
+        const std::tuple<T*...> components { reinterpret_cast<T*>(
+            data + archetype.offsets[columns[I]])... };
+
+        for (std::size_t row { 0 }; row < rows; ++row) {
+            fn(ids[row], std::get<I>(components)[row]...);
+        }
+    }
+
+    /// Returns the position of a type of component in the signature of an
+    /// archetype, or `s_npos` if it is not part of it.
+    [[nodiscard]] static std::size_t column(
+        const archetype& archetype, u32 component) noexcept;
+
+    /// Returns the address of a component within an archetype.
+    [[nodiscard]] void* element(const archetype& archetype,
+        std::size_t column, std::size_t row) const noexcept;
+
+    /// Returns the address of the identifier of an `::entity` within an
+    /// archetype.
+    [[nodiscard]] static entity* id_at(
+        const archetype& archetype, std::size_t row) noexcept;
+
+    /// Returns where the components of an `::entity` are stored, or `nullptr`
+    /// if it has none.
+    [[nodiscard]] const location* locate(entity entity) const noexcept;
+
+    /// Returns the archetype with the given sorted signature, creating it if
+    /// needed.
+    u32 archetype_of(std::vector<u32> signature);
+
+    /// Returns the archetype whose signature is only the given type of
+    /// component, creating it if needed.
+    u32 root(u32 component);
+
+    /// Returns the archetype with one more (`insert`) or one less type of
+    /// component than another archetype.
+    u32 neighbour(u32 archetype, u32 component, bool insert);
+
+    /// Moves an `::entity` and the components it keeps to another archetype.
+    ///
+    /// \return The uninitialized slot of the `component` column in the
+    ///     `::entity`'s new row, or `nullptr` if `component` is `s_none`.
+    void* move_entity(entity entity, u32 target, u32 component);
+
+    /// Moves the last row of an archetype into a row whose components were
+    /// already moved or destroyed.
+    void fill_hole(archetype& archetype, std::size_t row) noexcept;
+
+    /// Returns the archetypes whose signatures include every given type of
+    /// component.
+    std::span<const u32> matching(
+        u32 query, std::initializer_list<u32> components);
+
+    std::vector<component_info> m_components;
+    std::vector<archetype> m_archetypes;
+    std::map<std::vector<u32>, u32> m_signatures;
+    std::vector<location> m_locations;
+    std::vector<query> m_queries;
+};
+
+} // namespace eecs
+
+#endif // !EECS_ARCHETYPE_STORAGE_HPP
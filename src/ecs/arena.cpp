@@ -0,0 +1,42 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace eecs {
+
+void* arena::allocate(const std::size_t size, const std::size_t alignment)
+{
+    while (m_current < m_blocks.size()) {
+        block& block { m_blocks[m_current] };
+        const auto base { reinterpret_cast<std::uintptr_t>(block.data.get()) };
+        const std::uintptr_t aligned { (base + m_offset + alignment - 1)
+            & ~(std::uintptr_t { alignment } - 1) };
+
+        if (aligned + size <= base + block.size) {
+            m_offset = aligned + size - base;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        ++m_current;
+        m_offset = 0;
+    }
+
+    const std::size_t block_size { std::max(arena::block_size,
+        size + alignment) };
+    m_blocks.push_back(block {
+        .data = std::make_unique_for_overwrite<std::byte[]>(block_size),
+        .size = block_size });
+
+    return allocate(size, alignment);
+}
+
+void arena::reset() noexcept
+{
+    m_current = 0;
+    m_offset = 0;
+}
+
+} // namespace eecs
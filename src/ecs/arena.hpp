@@ -0,0 +1,52 @@
+#ifndef EECS_ARENA_HPP
+#define EECS_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace eecs {
+
+/// A bump allocator that hands out memory from large blocks and releases all
+/// of it at once.
+///
+/// Blocks are kept across `reset()`s, so an arena that is reused every frame
+/// stops allocating once it has grown to its working size. Objects placed in
+/// an arena are never destroyed by it.
+class arena {
+public:
+    /// The size, in bytes, of each block.
+    static constexpr std::size_t block_size { std::size_t { 16 } * 1024 };
+
+    arena() = default;
+    arena(const arena& other) = delete;
+    arena(arena&& other) noexcept = default;
+    arena& operator=(const arena& other) = delete;
+    arena& operator=(arena&& other) noexcept = default;
+    ~arena() = default;
+
+    /// Allocates uninitialized memory.
+    ///
+    /// \param size The size, in bytes, of the memory.
+    /// \param alignment The alignment, in bytes, of the memory. Must be a
+    ///     power of two.
+    /// \return A pointer to the memory, valid until the next `reset()`.
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment);
+
+    /// Releases every allocation, keeping the blocks for reuse.
+    void reset() noexcept;
+
+private:
+    struct block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<block> m_blocks;
+    std::size_t m_current { 0 };
+    std::size_t m_offset { 0 };
+};
+
+} // namespace eecs
+
+#endif // !EECS_ARENA_HPP
@@ -0,0 +1,85 @@
+#include "command_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+namespace eecs {
+
+void command_buffer::flush(world& world)
+{
+    // The changes are taken out of the buffer, so that the lock is not held
+    // while applying them and hooks can record more.
+    batch batch;
+    {
+        const std::lock_guard lock { m_mutex };
+        std::swap(batch, m_batch);
+    }
+
+    std::vector<entity> created(batch.created);
+    for (entity& entity : created) {
+        entity = world.create();
+    }
+
+    // Grouping the changes by collection keeps each collection hot while its
+    // changes are applied, and the stable sort preserves their order.
+    std::ranges::stable_sort(batch.commands, {}, &command::pool);
+
+    std::size_t applied { 0 };
+    try {
+        for (; applied < batch.commands.size(); ++applied) {
+            command& command { batch.commands[applied] };
+            const entity target { command.pending ? created[command.target]
+                                                  : command.target };
+
+            if (world.valid(target)) {
+                command.apply(world, target, command.payload);
+            }
+            if (command.destroy != nullptr) {
+                command.destroy(command.payload);
+            }
+        }
+
+        for (const entity entity : batch.destroyed) {
+            if (world.valid(entity)) {
+                world.destroy(entity);
+            }
+        }
+    } catch (...) {
+        batch.commands.erase(batch.commands.begin(),
+            batch.commands.begin() + static_cast<std::ptrdiff_t>(applied));
+        batch.clear();
+        throw;
+    }
+
+    batch.commands.clear();
+    batch.clear();
+
+    // The memory is handed back for the next changes, unless some were
+    // recorded in the meantime.
+    const std::lock_guard lock { m_mutex };
+    if (m_batch.empty()) {
+        std::swap(batch, m_batch);
+    }
+}
+
+void command_buffer::batch::clear() noexcept
+{
+    for (const command& command : commands) {
+        if (command.destroy != nullptr) {
+            command.destroy(command.payload);
+        }
+    }
+
+    commands.clear();
+    destroyed.clear();
+    created = 0;
+    payloads.reset();
+}
+
+} // namespace eecs
@@ -0,0 +1,225 @@
+#ifndef EECS_COMMAND_BUFFER_HPP
+#define EECS_COMMAND_BUFFER_HPP
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "entity.hpp"
+#include "family.hpp"
+#include "types.hpp"
+#include "world.hpp"
+
+namespace eecs {
+
+/// A recording of structural changes to a `::world`, applied later in a
+/// single batch.
+///
+/// Inserting or erasing components while iterating over them can relocate
+/// or reorder the very elements being iterated. Recording the changes instead
+/// and flushing them once iteration is over keeps iteration safe. Recording
+/// is thread-safe, so systems running concurrently may share a buffer.
+///
+/// When flushed, pending entities are created first, then component changes
+/// are applied grouped by type of component, in the order they were recorded
+/// for each type, and entities are destroyed last. Changes to entities that
+/// are no longer valid are dropped. Changes recorded while flushing, e.g.,
+/// by hooks notified of the changes being applied, are applied by the next
+/// flush.
+class command_buffer {
+public:
+    /// A placeholder for an `::entity` that is created when the buffer is
+    /// flushed.
+    struct pending_entity {
+        u32 index;
+    };
+
+    command_buffer() = default;
+    command_buffer(const command_buffer& other) = delete;
+    command_buffer(command_buffer&& other) noexcept = delete;
+    command_buffer& operator=(const command_buffer& other) = delete;
+    command_buffer& operator=(command_buffer&& other) noexcept = delete;
+
+    /// Destroys the buffer, dropping every unflushed change.
+    ~command_buffer() { m_batch.clear(); }
+
+    /// Records the creation of an `::entity`.
+    ///
+    /// \return A placeholder for the `::entity`, which components can be
+    ///     inserted into before it is created.
+    [[nodiscard]] pending_entity create()
+    {
+        const std::lock_guard lock { m_mutex };
+        return pending_entity { m_batch.created++ };
+    }
+
+    /// Records the insertion of a component.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \param entity The `::entity` to associate the component with.
+    /// \param component The component to insert.
+    template <typename T>
+    void insert(const entity entity, const T& component)
+    {
+        emplace<T>(entity, component);
+    }
+
+    /// Records the insertion of a component into a pending `::entity`.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \param entity The pending `::entity` to associate the component with.
+    /// \param component The component to insert.
+    template <typename T>
+    void insert(const pending_entity entity, const T& component)
+    {
+        emplace<T>(entity, component);
+    }
+
+    /// Records the insertion of a component constructed in-place with the
+    /// given `args`. The component is constructed immediately and moved into
+    /// the `::world` when the buffer is flushed.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \tparam Args The pack of component constructor parameter types.
+    /// \param entity The `::entity` to associate the component with.
+    /// \param args The arguments to forward to the constructor of the
+    ///     component.
+    template <typename T, typename... Args>
+    void emplace(const entity entity, Args&&... args)
+    {
+        record_emplace<T>(entity, false, std::forward<Args>(args)...);
+    }
+
+    /// Records the insertion of a component constructed in-place with the
+    /// given `args` into a pending `::entity`.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \tparam Args The pack of component constructor parameter types.
+    /// \param entity The pending `::entity` to associate the component with.
+    /// \param args The arguments to forward to the constructor of the
+    ///     component.
+    template <typename T, typename... Args>
+    void emplace(const pending_entity entity, Args&&... args)
+    {
+        record_emplace<T>(entity.index, true, std::forward<Args>(args)...);
+    }
+
+    /// Records the removal of a component.
+    ///
+    /// \tparam T The type of component to remove.
+    /// \param entity The `::entity` to remove the component from.
+    template <typename T>
+    void erase(const entity entity)
+    {
+        const std::lock_guard lock { m_mutex };
+        m_batch.commands.push_back(command {
+            .pool = pool_family::id<T>(),
+            .target = entity,
+            .pending = false,
+            .payload = nullptr,
+            .apply = &command_buffer::apply_erase<T>,
+            .destroy = nullptr,
+        });
+    }
+
+    /// Records the destruction of an `::entity`.
+    ///
+    /// \param entity The `::entity` to destroy.
+    void destroy(const entity entity)
+    {
+        const std::lock_guard lock { m_mutex };
+        m_batch.destroyed.push_back(entity);
+    }
+
+    /// Checks whether no changes are recorded.
+    ///
+    /// \return Whether the buffer is empty.
+    [[nodiscard]] bool empty() noexcept
+    {
+        const std::lock_guard lock { m_mutex };
+        return m_batch.empty();
+    }
+
+    /// Applies every recorded change to a `::world` and empties the buffer.
+    ///
+    /// \param world The `::world` to apply the changes to.
+    void flush(world& world);
+
+private:
+    using pool_family = family<struct command_pool_tag>;
+
+    /// A recorded change to a collection of components.
+    struct command {
+        u32 pool;
+        entity target;
+        bool pending;
+        void* payload;
+        void (*apply)(world& world, entity entity, void* payload);
+        void (*destroy)(void* payload) noexcept;
+    };
+
+    template <typename T, typename... Args>
+    void record_emplace(const entity target, const bool pending, Args&&... args)
+    {
+        const std::lock_guard lock { m_mutex };
+
+        void* payload { m_batch.payloads.allocate(sizeof(T), alignof(T)) };
+        ::new (payload) T(std::forward<Args>(args)...);
+
+        m_batch.commands.push_back(command {
+            .pool = pool_family::id<T>(),
+            .target = target,
+            .pending = pending,
+            .payload = payload,
+            .apply = &command_buffer::apply_emplace<T>,
+            .destroy = &command_buffer::destroy_payload<T>,
+        });
+    }
+
+    template <typename T>
+    static void apply_emplace(world& world, const entity entity, void* payload)
+    {
+        world.emplace<T>(entity, std::move(*static_cast<T*>(payload)));
+    }
+
+    template <typename T>
+    static void apply_erase(
+        world& world, const entity entity, void* /*payload*/)
+    {
+        world.erase<T>(entity);
+    }
+
+    template <typename T>
+    static void destroy_payload(void* payload) noexcept
+    {
+        std::destroy_at(static_cast<T*>(payload));
+    }
+
+    /// The changes recorded since the last flush.
+    struct batch {
+        arena payloads;
+        std::vector<command> commands;
+        std::vector<entity> destroyed;
+        u32 created { 0 };
+
+        /// Checks whether no changes are recorded.
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return created == 0 && commands.empty() && destroyed.empty();
+        }
+
+        /// Drops every recorded change, keeping the memory.
+        void clear() noexcept;
+    };
+
+    std::mutex m_mutex;
+    batch m_batch;
+};
+
+} // namespace eecs
+
+#endif // !EECS_COMMAND_BUFFER_HPP
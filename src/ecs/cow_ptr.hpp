@@ -0,0 +1,78 @@
+#ifndef EECS_COW_PTR_HPP
+#define EECS_COW_PTR_HPP
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace eecs {
+
+/// A pointer to an object that is shared until it is written to.
+///
+/// Sharing hands out read-only references to the current object. The next
+/// write through the pointer then copies the object, so the shared
+/// references keep observing the object as it was when it was shared.
+///
+/// Sharing and writing must happen on the same thread; the shared
+/// references may be read and released on any thread.
+///
+/// \tparam T The type of the object. Must be copy constructible.
+template <typename T>
+class cow_ptr {
+public:
+    /// Constructs a `::cow_ptr` to a default-constructed object.
+    cow_ptr()
+        : m_object(std::make_shared<T>())
+    {
+    }
+
+    /// Returns the object for reading.
+    ///
+    /// \return A constant reference to the object.
+    [[nodiscard]] const T& read() const noexcept { return *m_object; }
+
+    /// Returns the object for writing, copying it first if it is shared.
+    ///
+    /// \return A reference to the object, valid until it is shared.
+    [[nodiscard]] T& write()
+    {
+        if (shared()) {
+            m_object = std::make_shared<T>(std::as_const(*m_object));
+        }
+
+        return *m_object;
+    }
+
+    /// Checks whether the object is shared, i.e., whether the next `write()`
+    /// copies it.
+    ///
+    /// \return Whether the object is shared.
+    [[nodiscard]] bool shared() const noexcept
+    {
+        if (m_object.use_count() > 1) {
+            return true;
+        }
+
+        // `use_count()` is a relaxed load. Pairing it with the release of
+        // the last shared reference, which may have been on another thread,
+        // orders that thread's reads of the object before any write to it.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+    }
+
+    /// Shares the object.
+    ///
+    /// \return A read-only reference to the object, unaffected by later
+    ///     writes through this pointer.
+    [[nodiscard]] std::shared_ptr<const T> share() const noexcept
+    {
+        return m_object;
+    }
+
+private:
+    std::shared_ptr<T> m_object;
+};
+
+} // namespace eecs
+
+#endif // !EECS_COW_PTR_HPP
@@ -1,12 +1,81 @@
 #ifndef EECS_ENTITY_HPP
 #define EECS_ENTITY_HPP
 
+#include <concepts>
 #include <cstdint>
+#include <limits>
 
 namespace eecs {
 
+/// Describes how an identifier is split into an index and a version.
+///
+/// The lower bits of an identifier hold its index, which is what sparse
+/// arrays are indexed by. The upper bits hold its version, which is bumped
+/// every time the index is recycled so that stale identifiers can be told
+/// apart from live ones.
+///
+/// \tparam IdType The unsigned integral type of the identifier.
+template <std::unsigned_integral IdType>
+struct id_traits {
+    /// The number of bits used for the version. For a 32-bit identifier,
+    /// this leaves 22 bits for the index, i.e., about 4 million entities,
+    /// while a version only wraps around after 1024 recycles.
+    static constexpr int version_bits { std::numeric_limits<IdType>::digits
+        * 5 / 16 };
+
+    /// The number of bits used for the index.
+    static constexpr int index_bits { std::numeric_limits<IdType>::digits
+        - version_bits };
+
+    /// The mask of the index bits. Also used as the null index.
+    static constexpr IdType index_mask { static_cast<IdType>(
+        (IdType { 1 } << index_bits) - 1) };
+
+    /// The mask of the version bits, once shifted down.
+    static constexpr IdType version_mask { static_cast<IdType>(
+        (IdType { 1 } << version_bits) - 1) };
+
+    /// An identifier that never refers to anything.
+    static constexpr IdType null { std::numeric_limits<IdType>::max() };
+
+    /// Returns the index of an identifier.
+    ///
+    /// \param id The identifier.
+    /// \return The index of the identifier.
+    [[nodiscard]] static constexpr IdType to_index(const IdType id) noexcept
+    {
+        return id & index_mask;
+    }
+
+    /// Returns the version of an identifier.
+    ///
+    /// \param id The identifier.
+    /// \return The version of the identifier.
+    [[nodiscard]] static constexpr IdType to_version(const IdType id) noexcept
+    {
+        return static_cast<IdType>(id >> index_bits);
+    }
+
+    /// Combines an index and a version into an identifier.
+    ///
+    /// \param index The index of the identifier.
+    /// \param version The version of the identifier.
+    /// \return The identifier.
+    [[nodiscard]] static constexpr IdType construct(
+        const IdType index, const IdType version) noexcept
+    {
+        return static_cast<IdType>(
+            (index & index_mask) | ((version & version_mask) << index_bits));
+    }
+};
+
+/// An identifier for a unique "thing" in a `::world`, made up of an index
+/// and a version.
 using entity = uint32_t;
 
+/// An `::entity` that never refers to anything.
+inline constexpr entity null_entity { id_traits<entity>::null };
+
 } // namespace eecs
 
 #endif
@@ -0,0 +1,143 @@
+#ifndef EECS_EVENTS_HPP
+#define EECS_EVENTS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace eecs {
+
+/// A channel of events of type `T`, through which systems send messages to
+/// each other.
+///
+/// Events are kept in two buffers: the events sent during the current frame
+/// and those sent during the previous one. `update()` drops the older buffer
+/// and reuses its memory for the next frame, so once the buffers have grown
+/// to the busiest frame, sending does not allocate.
+///
+/// Each reader keeps its own cursor, so any number of systems can read every
+/// event once. An event can be read until the second `update()` after it was
+/// sent; readers that fall further behind miss it.
+///
+/// \tparam T The type of event.
+template <typename T>
+class events {
+public:
+    /// The position of a reader in a channel.
+    struct reader {
+        /// The sequence number of the next event to read.
+        u64 next { 0 };
+    };
+
+    /// Sends an event.
+    ///
+    /// \param event The event to send.
+    void send(const T& event) { m_newer.push_back(event); }
+
+    /// Sends an event constructed in-place with the given `args`.
+    ///
+    /// \tparam Args The pack of event constructor parameter types.
+    /// \param args The arguments to forward to the constructor of the event.
+    /// \return A reference to the event.
+    template <typename... Args>
+    T& emplace(Args&&... args)
+    {
+        return m_newer.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /// Sends several events at once.
+    ///
+    /// \param events The events to send.
+    void send(const std::span<const T> events)
+    {
+        m_newer.insert(m_newer.end(), events.begin(), events.end());
+    }
+
+    /// Returns the events a reader has not read yet and moves the reader
+    /// past them.
+    ///
+    /// \param reader The reader to read with.
+    /// \return The unread events, older first, as two contiguous runs.
+    ///     Invalidated by sending events or `update()`.
+    [[nodiscard]] std::array<std::span<const T>, 2> read(reader& reader) const
+    {
+        const u64 newer_start { m_older_start + m_older.size() };
+        const u64 next { std::max(reader.next, m_older_start) };
+        reader.next = newer_start + m_newer.size();
+
+        if (next >= newer_start) {
+            return { std::span<const T> {},
+                std::span<const T> { m_newer }.subspan(next - newer_start) };
+        }
+
+        return { std::span<const T> { m_older }.subspan(next - m_older_start),
+            std::span<const T> { m_newer } };
+    }
+
+    /// Invokes a function on each event a reader has not read yet, older
+    /// first, and moves the reader past them.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param reader The reader to read with.
+    /// \param fn The function to invoke with a constant reference to each
+    ///     event.
+    template <typename Fn>
+    void each(reader& reader, Fn&& fn) const
+    {
+        for (const std::span<const T> run : read(reader)) {
+            for (const T& event : run) {
+                fn(event);
+            }
+        }
+    }
+
+    /// Returns the number of events a reader has not read yet.
+    ///
+    /// \param reader The reader to check.
+    /// \return The number of unread events.
+    [[nodiscard]] std::size_t unread(const reader& reader) const noexcept
+    {
+        const u64 end { m_older_start + m_older.size() + m_newer.size() };
+        return static_cast<std::size_t>(
+            end - std::max(reader.next, m_older_start));
+    }
+
+    /// Returns a reader that only reads events sent from now on.
+    ///
+    /// \return The reader.
+    [[nodiscard]] reader latest() const noexcept
+    {
+        return reader { m_older_start + m_older.size() + m_newer.size() };
+    }
+
+    /// Drops the events sent before the previous `update()`, keeping their
+    /// memory for the events sent next.
+    void update() noexcept
+    {
+        m_older_start += m_older.size();
+        std::swap(m_older, m_newer);
+        m_newer.clear();
+    }
+
+    /// Drops every event, keeping their memory.
+    void clear() noexcept
+    {
+        m_older_start += m_older.size() + m_newer.size();
+        m_older.clear();
+        m_newer.clear();
+    }
+
+private:
+    std::vector<T> m_older;
+    std::vector<T> m_newer;
+    u64 m_older_start { 0 };
+};
+
+} // namespace eecs
+
+#endif // !EECS_EVENTS_HPP
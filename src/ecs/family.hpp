@@ -0,0 +1,38 @@
+#ifndef EECS_FAMILY_HPP
+#define EECS_FAMILY_HPP
+
+#include <atomic>
+
+#include "types.hpp"
+
+namespace eecs {
+
+/// A generator of sequential, per-process identifiers for types.
+///
+/// Each `Family` tag has its own counter, so identifiers are dense within a
+/// family and suitable for indexing flat arrays. Identifiers are assigned on
+/// first use and are stable for the lifetime of the process, but not across
+/// processes.
+///
+/// \tparam Family A tag type that distinguishes independent counters.
+template <typename Family>
+class family {
+public:
+    /// Returns the identifier of a type within this family.
+    ///
+    /// \tparam T The type to identify.
+    /// \return The identifier of `T`.
+    template <typename T>
+    [[nodiscard]] static u32 id() noexcept
+    {
+        static const u32 s_id { s_next.fetch_add(1) };
+        return s_id;
+    }
+
+private:
+    inline static std::atomic<u32> s_next { 0 };
+};
+
+} // namespace eecs
+
+#endif // !EECS_FAMILY_HPP
@@ -0,0 +1,149 @@
+#ifndef EECS_GROUP_HPP
+#define EECS_GROUP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "cow_ptr.hpp"
+#include "entity.hpp"
+#include "sparse_set.hpp"
+#include "types.hpp"
+
+namespace eecs {
+
+/// A non-owning handle to an owning group of component collections.
+///
+/// The `::world` keeps the collections of an owning group arranged so that
+/// every `::entity` associated with all of the grouped types of components
+/// occupies the same position within the first `size()` elements of each
+/// collection. Iterating a group is therefore a linear walk over contiguous
+/// arrays, without any lookups.
+///
+/// The collections are resolved through their copy-on-write pointers on each
+/// use, so a group stays valid across `world::freeze()`.
+///
+/// Like a `::view`, a non-`const` type yields a reference to the component
+/// and stamps it as changed at the `::world`'s current tick; a
+/// `const`-qualified one yields a constant reference and only reads its
+/// collection, so that it is not copied after `world::freeze()`.
+///
+/// \tparam T The types of components owned by the group, optionally
+///     `const`-qualified.
+template <typename... T>
+class group {
+    static_assert(sizeof...(T) > 1, "A group needs at least two components");
+
+    /// The copy-on-write pointer to the collection of an owned type.
+    template <typename U>
+    using pool = cow_ptr<sparse_set<std::remove_const_t<U>>>;
+
+public:
+    /// Constructs a `::group` over the given component collections.
+    ///
+    /// \param tick The current tick of the owning `::world`, which yielded
+    ///     components are stamped with.
+    /// \param size The number of entities in the group, kept up to date by
+    ///     the owning `::world`.
+    /// \param pools The component collections owned by the group.
+    explicit group(const std::atomic<u32>& tick, const std::size_t& size,
+        pool<T>&... pools) noexcept
+        : m_tick(&tick)
+        , m_size(&size)
+        , m_pools(&pools...)
+    {
+    }
+
+    /// Returns the number of entities in the group.
+    ///
+    /// \return The number of entities in the group.
+    [[nodiscard]] std::size_t size() const noexcept { return *m_size; }
+
+    /// Checks whether the group is empty.
+    ///
+    /// \return Whether the group is empty.
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// Returns the entities in the group, in iteration order.
+    ///
+    /// \return A view of the grouped entities.
+    [[nodiscard]] std::span<const entity> ids() const noexcept
+    {
+        return std::get<0>(m_pools)->read().ids().first(size());
+    }
+
+    /// Checks whether an `::entity` is in the group.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` is in the group; `false` otherwise.
+    [[nodiscard]] bool contains(const entity entity) const noexcept
+    {
+        const auto& pool { std::get<0>(m_pools)->read() };
+        return pool.contains(entity) && pool.index(entity) < size();
+    }
+
+    /// Invokes a function on each `::entity` in the group and its components.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param fn The function to invoke with the `::entity` followed by a
+    ///     reference to each of its grouped components.
+    template <typename Fn>
+    void each(Fn&& fn) const
+    {
+        each(fn, std::index_sequence_for<T...> {});
+    }
+
+private:
+    /// The component collection of an owned type, constant if the type is.
+    template <typename U>
+    using collection = std::conditional_t<std::is_const_v<U>,
+        const sparse_set<std::remove_const_t<U>>,
+        sparse_set<std::remove_const_t<U>>>;
+
+    /// Returns the component collection of an owned type, for writing only
+    /// if the type is not `const`-qualified.
+    template <typename U, std::size_t I>
+    [[nodiscard]] collection<U>& resolve() const
+    {
+        if constexpr (std::is_const_v<U>) {
+            return std::get<I>(m_pools)->read();
+        } else {
+            return std::get<I>(m_pools)->write();
+        }
+    }
+
+    /// Stamps a component as changed if it is yielded for writing.
+    template <typename U>
+    static void stamp(
+        collection<U>& pool, const std::size_t index, const u32 tick) noexcept
+    {
+        if constexpr (!std::is_const_v<U>) {
+            pool.ticks()[index].changed = tick;
+        }
+    }
+
+    template <typename Fn, std::size_t... I>
+    void each(Fn& fn, std::index_sequence<I...> /*unused*/) const
+    {
+        const std::tuple<collection<T>&...> pools { resolve<T, I>()... };
+        const std::tuple<T*...> data { std::get<I>(pools).data()... };
+        const std::span<const entity> ids { this->ids() };
+        const u32 tick { m_tick->load(std::memory_order_relaxed) };
+
+        for (std::size_t i { 0 }; i < ids.size(); ++i) {
+            (stamp<T>(std::get<I>(pools), i, tick), ...);
+            fn(ids[i], std::get<I>(data)[i]...);
+        }
+    }
+
+    const std::atomic<u32>* m_tick;
+    const std::size_t* m_size;
+    std::tuple<pool<T>*...> m_pools;
+};
+
+} // namespace eecs
+
+#endif // !EECS_GROUP_HPP
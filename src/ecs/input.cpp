@@ -1,37 +1,104 @@
 #include "input.hpp"
 
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
-#include <print>
-#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
 
 #include "SDL3/SDL_events.h"
-#include "SDL3/SDL_keycode.h"
+#include "SDL3/SDL_scancode.h"
 
 namespace eecs {
 
+namespace {
+
+    constexpr std::size_t key_count { std::to_underlying(key::count) };
+
+    using key_set = std::bitset<key_count>;
+
+    /// Maps each SDL scancode to the key at its position, or to `key::count`
+    /// if it has none.
+    constexpr std::array<key, SDL_SCANCODE_COUNT> keys_by_scancode {
+        [] {
+            std::array<key, SDL_SCANCODE_COUNT> keys {};
+            keys.fill(key::count);
+
+            keys[SDL_SCANCODE_LEFT] = key::left;
+            keys[SDL_SCANCODE_RIGHT] = key::right;
+            keys[SDL_SCANCODE_UP] = key::up;
+            keys[SDL_SCANCODE_DOWN] = key::down;
+            for (int letter { 0 }; letter < 26; ++letter) {
+                keys[SDL_SCANCODE_A + letter]
+                    = static_cast<key>(std::to_underlying(key::a) + letter);
+            }
+            keys[SDL_SCANCODE_SPACE] = key::space;
+            keys[SDL_SCANCODE_RETURN] = key::enter;
+            keys[SDL_SCANCODE_ESCAPE] = key::escape;
+
+            return keys;
+        }()
+    };
+
+} // namespace
+
 class input::impl {
 public:
-    [[nodiscard]] bool is_key_pressed(const key key)
+    [[nodiscard]] action add_action(const std::initializer_list<key> keys)
     {
-        if (key == key::up && m_pressed[SDLK_UP]) {
-            return true;
+        const auto action { static_cast<eecs::action>(m_actions.size()) };
+        key_set& bound { m_actions.emplace_back() };
+        for (const key key : keys) {
+            bound.set(std::to_underlying(key));
         }
-        if (key == key::down && m_pressed[SDLK_DOWN]) {
-            return true;
-        }
-        if (key == key::left && m_pressed[SDLK_LEFT]) {
-            return true;
-        }
-        if (key == key::right && m_pressed[SDLK_RIGHT]) {
-            return true;
-        }
-        return false;
+
+        return action;
+    }
+
+    void bind(const action action, const key key)
+    {
+        m_actions[std::to_underlying(action)].set(std::to_underlying(key));
+    }
+
+    [[nodiscard]] bool is_key_pressed(const key key) const
+    {
+        return m_pressed.test(std::to_underlying(key));
+    }
+
+    [[nodiscard]] bool is_just_pressed(const key key) const
+    {
+        return m_pressed_at[std::to_underlying(key)] == m_frame;
+    }
+
+    [[nodiscard]] bool is_just_released(const key key) const
+    {
+        return m_released_at[std::to_underlying(key)] == m_frame;
+    }
+
+    [[nodiscard]] bool is_action_pressed(const action action) const
+    {
+        return (m_pressed & m_actions[std::to_underlying(action)]).any();
+    }
+
+    [[nodiscard]] bool is_action_just_pressed(const action action) const
+    {
+        return any_bound(action, m_pressed_at);
+    }
+
+    [[nodiscard]] bool is_action_just_released(const action action) const
+    {
+        return any_bound(action, m_released_at);
     }
 
     void poll()
     {
-        m_just_pressed.clear();
-        m_just_released.clear();
+        // Keys stamped during an earlier frame no longer match, so nothing
+        // needs to be cleared.
+        ++m_frame;
 
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -39,16 +106,27 @@ public:
                 m_quit = true;
             }
 
+            if (event.type != SDL_EVENT_KEY_DOWN
+                && event.type != SDL_EVENT_KEY_UP) {
+                continue;
+            }
+
+            const key mapped { event.key.scancode < SDL_SCANCODE_COUNT
+                    ? keys_by_scancode[event.key.scancode]
+                    : key::count };
+            if (mapped == key::count) {
+                continue;
+            }
+
+            const auto index { std::to_underlying(mapped) };
             if (event.type == SDL_EVENT_KEY_DOWN) {
-                m_pressed[event.key.key] = true;
+                m_pressed.set(index);
                 if (!event.key.repeat) {
-                    m_just_pressed[event.key.key] = true;
+                    m_pressed_at[index] = m_frame;
                 }
-            }
-
-            if (event.type == SDL_EVENT_KEY_UP) {
-                m_pressed[event.key.key] = false;
-                m_just_released[event.key.key] = true;
+            } else {
+                m_pressed.reset(index);
+                m_released_at[index] = m_frame;
             }
         }
     }
@@ -56,9 +134,28 @@ public:
     [[nodiscard]] bool quit() const { return m_quit; }
 
 private:
-    std::unordered_map<SDL_Keycode, bool> m_pressed;
-    std::unordered_map<SDL_Keycode, bool> m_just_pressed;
-    std::unordered_map<SDL_Keycode, bool> m_just_released;
+    /// Checks whether any key bound to an action was stamped during the
+    /// current frame.
+    [[nodiscard]] bool any_bound(const action action,
+        const std::array<u32, key_count>& stamps) const
+    {
+        const key_set& bound { m_actions[std::to_underlying(action)] };
+        for (std::size_t key { 0 }; key < key_count; ++key) {
+            if (bound.test(key) && stamps[key] == m_frame) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    key_set m_pressed;
+    // The frame each key last went down and up. Frames are counted from 1,
+    // so keys that never did do not match.
+    std::array<u32, key_count> m_pressed_at {};
+    std::array<u32, key_count> m_released_at {};
+    u32 m_frame { 1 };
+    std::vector<key_set> m_actions;
     bool m_quit { false };
 };
 
@@ -67,13 +164,52 @@ input::input()
 {
 }
 
+input::input(input&& other) noexcept = default;
+
+input& input::operator=(input&& other) noexcept = default;
+
 input::~input() = default;
 
-bool input::is_key_pressed(const key key)
+action input::add_action(const std::initializer_list<key> keys)
+{
+    return m_pimpl->add_action(keys);
+}
+
+void input::bind(const action action, const key key)
+{
+    m_pimpl->bind(action, key);
+}
+
+bool input::is_key_pressed(const key key) const
 {
     return m_pimpl->is_key_pressed(key);
 }
 
+bool input::is_just_pressed(const key key) const
+{
+    return m_pimpl->is_just_pressed(key);
+}
+
+bool input::is_just_released(const key key) const
+{
+    return m_pimpl->is_just_released(key);
+}
+
+bool input::is_action_pressed(const action action) const
+{
+    return m_pimpl->is_action_pressed(action);
+}
+
+bool input::is_action_just_pressed(const action action) const
+{
+    return m_pimpl->is_action_just_pressed(action);
+}
+
+bool input::is_action_just_released(const action action) const
+{
+    return m_pimpl->is_action_just_released(action);
+}
+
 void input::poll() { m_pimpl->poll(); }
 
 bool input::quit() const { return m_pimpl->quit(); }
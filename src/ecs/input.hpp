@@ -2,6 +2,7 @@
 #define EECS_INPUT_HPP
 
 #include <cstdint>
+#include <initializer_list>
 #include <memory>
 
 namespace eecs {
@@ -24,16 +25,74 @@ enum class key : uint8_t {
     k,
     l,
     m,
-    n
+    n,
+    o,
+    p,
+    q,
+    r,
+    s,
+    t,
+    u,
+    v,
+    w,
+    x,
+    y,
+    z,
+    space,
+    enter,
+    escape,
+    count, // Represents the number of key enums.
 };
 
+/// A handle to an action registered with `input::add_action()`.
+enum class action : uint16_t { };
+
+/// A resource holding the state of the keyboard, updated once per frame by
+/// `poll()`.
+///
+/// Keys are identified by their physical position, so that bindings do not
+/// depend on the keyboard layout.
 class input {
 public:
     input();
+    input(const input& other) = delete;
+    input(input&& other) noexcept;
+    input& operator=(const input& other) = delete;
+    input& operator=(input&& other) noexcept;
     ~input();
 
-    void add_action();
-    [[nodiscard]] bool is_key_pressed(key key);
+    /// Registers an action, triggered by any of the given keys.
+    ///
+    /// \param keys The keys bound to the action.
+    /// \return A handle to the action.
+    [[nodiscard]] action add_action(std::initializer_list<key> keys);
+
+    /// Binds another key to an action.
+    ///
+    /// \param action The action to bind the key to.
+    /// \param key The key to bind.
+    void bind(action action, key key);
+
+    /// Checks whether a key is held down.
+    [[nodiscard]] bool is_key_pressed(key key) const;
+
+    /// Checks whether a key went down during the last `poll()`.
+    [[nodiscard]] bool is_just_pressed(key key) const;
+
+    /// Checks whether a key went up during the last `poll()`.
+    [[nodiscard]] bool is_just_released(key key) const;
+
+    /// Checks whether any key bound to an action is held down.
+    [[nodiscard]] bool is_action_pressed(action action) const;
+
+    /// Checks whether any key bound to an action went down during the last
+    /// `poll()`.
+    [[nodiscard]] bool is_action_just_pressed(action action) const;
+
+    /// Checks whether any key bound to an action went up during the last
+    /// `poll()`.
+    [[nodiscard]] bool is_action_just_released(action action) const;
+
     void poll();
     [[nodiscard]] bool quit() const;
 
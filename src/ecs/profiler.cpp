@@ -0,0 +1,190 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace eecs {
+
+namespace {
+
+    /// Returns a small number identifying the calling thread.
+    u32 thread_number() noexcept
+    {
+        static std::atomic<u32> next { 0 };
+        thread_local const u32 number { next.fetch_add(1) };
+        return number;
+    }
+
+    /// Writes a string as a JSON string literal.
+    void write_string(std::ostream& out, const std::string_view string)
+    {
+        constexpr std::string_view hex { "0123456789abcdef" };
+
+        out << '"';
+        for (const char character : string) {
+            const auto code { static_cast<unsigned char>(character) };
+            if (character == '"' || character == '\\') {
+                out << '\\' << character;
+            } else if (code < 0x20) {
+                out << "\\u00" << hex[code >> 4] << hex[code & 0xf];
+            } else {
+                out << character;
+            }
+        }
+        out << '"';
+    }
+
+    /// Converts a duration to fractional microseconds, the unit of trace
+    /// events.
+    double microseconds(const profiler::clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::micro> { duration }.count();
+    }
+
+} // namespace
+
+profiler::profiler(
+    const std::size_t sample_capacity, const std::size_t frame_capacity)
+    : m_samples(std::max<std::size_t>(sample_capacity, 1))
+    , m_frames(std::max<std::size_t>(frame_capacity, 1))
+{
+}
+
+profiler::profiler(profiler&& other) noexcept
+    : m_samples(std::move(other.m_samples))
+    , m_sample_count(other.m_sample_count.load())
+    , m_frames(std::move(other.m_frames))
+    , m_frame_count(other.m_frame_count)
+    , m_frame(other.m_frame)
+    , m_frame_start(other.m_frame_start)
+    , m_epoch(other.m_epoch)
+{
+}
+
+void profiler::begin_frame(const u64 number)
+{
+    m_frame = number;
+    m_frame_start = clock::now();
+}
+
+void profiler::end_frame(const std::size_t entities)
+{
+    m_frames[m_frame_count++ % m_frames.size()] = frame {
+        .number = m_frame,
+        .start = m_frame_start,
+        .duration = clock::now() - m_frame_start,
+        .entities = entities,
+    };
+}
+
+void profiler::record(const std::string_view name,
+    const clock::time_point start, const clock::time_point end)
+{
+    const u64 index { m_sample_count.fetch_add(1, std::memory_order_relaxed) };
+
+    // Assigning field by field reuses the storage of the name replaced.
+    sample& sample { m_samples[index % m_samples.size()] };
+    sample.name.assign(name);
+    sample.frame = m_frame;
+    sample.thread = thread_number();
+    sample.start = start;
+    sample.duration = end - start;
+}
+
+std::vector<profiler::sample> profiler::samples(
+    const u64 first, const u64 last) const
+{
+    const u64 count { m_sample_count.load(std::memory_order_relaxed) };
+    const u64 kept { std::min<u64>(count, m_samples.size()) };
+
+    std::vector<sample> samples;
+    for (u64 i { count - kept }; i < count; ++i) {
+        const sample& sample { m_samples[i % m_samples.size()] };
+        if (sample.frame >= first && sample.frame <= last) {
+            samples.push_back(sample);
+        }
+    }
+
+    return samples;
+}
+
+std::vector<profiler::frame> profiler::frames(
+    const u64 first, const u64 last) const
+{
+    const u64 kept { std::min<u64>(m_frame_count, m_frames.size()) };
+
+    std::vector<frame> frames;
+    for (u64 i { m_frame_count - kept }; i < m_frame_count; ++i) {
+        const frame& frame { m_frames[i % m_frames.size()] };
+        if (frame.number >= first && frame.number <= last) {
+            frames.push_back(frame);
+        }
+    }
+
+    return frames;
+}
+
+std::vector<profiler::summary> profiler::summarize(
+    const u64 first, const u64 last) const
+{
+    std::vector<summary> summaries;
+    for (const sample& sample : samples(first, last)) {
+        auto it { std::ranges::find(summaries, sample.name, &summary::name) };
+        if (it == summaries.end()) {
+            it = summaries.insert(it,
+                summary {
+                    .name = sample.name,
+                    .calls = 0,
+                    .total = clock::duration::zero(),
+                    .longest = clock::duration::zero(),
+                });
+        }
+
+        ++it->calls;
+        it->total += sample.duration;
+        it->longest = std::max(it->longest, sample.duration);
+    }
+
+    return summaries;
+}
+
+void profiler::write_trace(
+    std::ostream& out, const u64 first, const u64 last) const
+{
+    out << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+    const char* separator { "" };
+    for (const frame& frame : frames(first, last)) {
+        out << separator
+            << R"({"name":"frame","cat":"frame","ph":"X","pid":0,"tid":0,)"
+            << R"("ts":)" << microseconds(frame.start - m_epoch)
+            << R"(,"dur":)" << microseconds(frame.duration)
+            << R"(,"args":{"frame":)" << frame.number
+            << R"(,"entities":)" << frame.entities << "}}";
+        separator = ",";
+    }
+
+    for (const sample& sample : samples(first, last)) {
+        out << separator << R"({"name":)";
+        write_string(out, sample.name);
+        out << R"(,"cat":"system","ph":"X","pid":0,"tid":)"
+            << sample.thread + 1 << R"(,"ts":)"
+            << microseconds(sample.start - m_epoch) << R"(,"dur":)"
+            << microseconds(sample.duration) << R"(,"args":{"frame":)"
+            << sample.frame << "}}";
+        separator = ",";
+    }
+
+    out << "]}";
+}
+
+} // namespace eecs
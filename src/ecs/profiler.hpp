@@ -0,0 +1,143 @@
+#ifndef EECS_PROFILER_HPP
+#define EECS_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.hpp"
+
+namespace eecs {
+
+/// A resource that records how long each system runs, frame by frame.
+///
+/// Schedules run on a `::world` that has a `::profiler` time each of their
+/// systems into it; an `::app` also marks the start and end of each frame.
+/// Samples are kept in fixed-size ring buffers, so the most recent ones are
+/// always available. Each sample keeps a copy of its system's name, whose
+/// storage is reused once the buffer wraps around.
+///
+/// Samples may be recorded from several threads at once, but must not be
+/// read while systems are running.
+class profiler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// A single run of a system.
+    struct sample {
+        /// The name of the system.
+        std::string name;
+        /// The frame the system ran in.
+        u64 frame;
+        /// The thread the system ran on.
+        u32 thread;
+        /// When the system started.
+        clock::time_point start;
+        /// How long the system ran.
+        clock::duration duration;
+    };
+
+    /// A single frame.
+    struct frame {
+        /// The number of the frame.
+        u64 number;
+        /// When the frame started.
+        clock::time_point start;
+        /// How long the frame took.
+        clock::duration duration;
+        /// The number of alive entities at the end of the frame.
+        std::size_t entities;
+    };
+
+    /// The summary of the runs of a system over several frames.
+    struct summary {
+        /// The name of the system.
+        std::string name;
+        /// The number of runs.
+        u64 calls;
+        /// The total time of the runs.
+        clock::duration total;
+        /// The time of the longest run.
+        clock::duration longest;
+    };
+
+    /// Constructs a `::profiler` with the given capacities.
+    ///
+    /// \param sample_capacity The number of system samples to keep.
+    /// \param frame_capacity The number of frames to keep.
+    explicit profiler(
+        std::size_t sample_capacity = 65536, std::size_t frame_capacity = 256);
+    profiler(const profiler& other) = delete;
+    profiler(profiler&& other) noexcept;
+    profiler& operator=(const profiler& other) = delete;
+    profiler& operator=(profiler&& other) noexcept = delete;
+    ~profiler() = default;
+
+    /// Marks the start of a frame. Systems recorded from now on belong to it.
+    ///
+    /// \param number The number of the frame.
+    void begin_frame(u64 number);
+
+    /// Marks the end of the current frame.
+    ///
+    /// \param entities The number of alive entities.
+    void end_frame(std::size_t entities);
+
+    /// Records a run of a system in the current frame. May be called from
+    /// several threads at once.
+    ///
+    /// \param name The name of the system, which is copied.
+    /// \param start When the system started.
+    /// \param end When the system finished.
+    void record(
+        std::string_view name, clock::time_point start, clock::time_point end);
+
+    /// Returns the kept samples of the systems run in frames `[first, last]`,
+    /// oldest first.
+    ///
+    /// \param first The first frame.
+    /// \param last The last frame.
+    /// \return The samples.
+    [[nodiscard]] std::vector<sample> samples(u64 first, u64 last) const;
+
+    /// Returns the kept frames numbered `[first, last]`, oldest first.
+    ///
+    /// \param first The first frame.
+    /// \param last The last frame.
+    /// \return The frames.
+    [[nodiscard]] std::vector<frame> frames(u64 first, u64 last) const;
+
+    /// Summarizes the kept samples of each system run in frames
+    /// `[first, last]`, in order of first run.
+    ///
+    /// \param first The first frame.
+    /// \param last The last frame.
+    /// \return The summary of each system.
+    [[nodiscard]] std::vector<summary> summarize(u64 first, u64 last) const;
+
+    /// Writes the kept frames and samples of frames `[first, last]` as a
+    /// Chrome trace-event JSON document, which `chrome://tracing` and
+    /// Perfetto can display as a timeline.
+    ///
+    /// \param out The stream to write to.
+    /// \param first The first frame.
+    /// \param last The last frame.
+    void write_trace(std::ostream& out, u64 first, u64 last) const;
+
+private:
+    std::vector<sample> m_samples;
+    std::atomic<u64> m_sample_count { 0 };
+    std::vector<frame> m_frames;
+    u64 m_frame_count { 0 };
+    u64 m_frame { 0 };
+    clock::time_point m_frame_start;
+    clock::time_point m_epoch { clock::now() };
+};
+
+} // namespace eecs
+
+#endif // !EECS_PROFILER_HPP
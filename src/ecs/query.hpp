@@ -0,0 +1,228 @@
+#ifndef EECS_QUERY_HPP
+#define EECS_QUERY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+#include "cow_ptr.hpp"
+#include "entity.hpp"
+#include "sparse_set.hpp"
+#include "types.hpp"
+
+namespace eecs {
+
+/// The entities associated with all of the given types of components, kept
+/// up to date by hooks on their component collections.
+///
+/// The hooks are connected with the address of the state, so it can be
+/// neither copied nor moved.
+///
+/// \tparam T The types of components to match.
+template <typename... T>
+class query_state {
+public:
+    /// Constructs a `::query_state` over the given component collections,
+    /// matching the entities already associated with all of them.
+    ///
+    /// \param pools The component collections to match.
+    explicit query_state(cow_ptr<sparse_set<T>>&... pools)
+        : m_pools(&pools...)
+    {
+        (pools.write().on_insert({ &query_state::on_insert, this }), ...);
+        (pools.write().on_erase({ &query_state::on_erase, this }), ...);
+
+        // Only the entities of the smallest collection can match.
+        std::span<const entity> candidates {
+            std::get<0>(m_pools)->read().ids()
+        };
+        ((candidates = pools.read().size() < candidates.size()
+                 ? pools.read().ids()
+                 : candidates),
+            ...);
+
+        for (const entity entity : candidates) {
+            on_insert(this, entity);
+        }
+    }
+
+    query_state(const query_state&) = delete;
+    query_state(query_state&&) = delete;
+    query_state& operator=(const query_state&) = delete;
+    query_state& operator=(query_state&&) = delete;
+    ~query_state() = default;
+
+    /// Returns the matching entities.
+    ///
+    /// \return A view of the densely packed matching entities.
+    [[nodiscard]] std::span<const entity> ids() const noexcept
+    {
+        return m_matches.ids();
+    }
+
+    /// Checks whether an `::entity` matches.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` matches; `false` otherwise.
+    [[nodiscard]] bool contains(const entity entity) const noexcept
+    {
+        return m_matches.contains(entity);
+    }
+
+    /// Returns the copy-on-write pointer to a matched component collection.
+    ///
+    /// \tparam U The type of component collection to return.
+    /// \return The copy-on-write pointer to the component collection.
+    template <typename U>
+    [[nodiscard]] cow_ptr<sparse_set<U>>& pool() const noexcept
+    {
+        return *std::get<cow_ptr<sparse_set<U>>*>(m_pools);
+    }
+
+private:
+    /// The value of a match, which only needs its identifier.
+    struct match { };
+
+    /// Matches an `::entity` that was given a component, if it is now
+    /// associated with all of the components.
+    static void on_insert(void* context, const entity entity)
+    {
+        query_state& self { *static_cast<query_state*>(context) };
+
+        if ((self.pool<T>().read().contains(entity) && ...)) {
+            self.m_matches.emplace(entity);
+        }
+    }
+
+    /// Stops matching an `::entity` that is about to lose a component.
+    static void on_erase(void* context, const entity entity)
+    {
+        static_cast<query_state*>(context)->m_matches.erase(entity);
+    }
+
+    std::tuple<cow_ptr<sparse_set<T>>*...> m_pools;
+    sparse_set<match> m_matches;
+};
+
+/// A non-owning handle to a persistent query over the entities associated
+/// with all of the given types of components.
+///
+/// Unlike a `::view`, which intersects the component collections on every
+/// iteration, a query keeps the matching entities packed in a list that the
+/// `::world` updates as components are inserted and erased. Iterating it
+/// visits the matching entities only, at the cost of a lookup per component.
+///
+/// A non-`const` type yields a reference to the component and stamps it as
+/// changed; a `const`-qualified one yields a constant reference. Components
+/// of the queried types must not be inserted or erased while iterating.
+///
+/// \tparam T The types of components to match, optionally
+///     `const`-qualified.
+template <typename... T>
+class query {
+public:
+    using state = query_state<std::remove_const_t<T>...>;
+
+    /// Constructs a `::query` over a persistent query state.
+    ///
+    /// \param tick The current tick of the owning `::world`, which components
+    ///     yielded for writing are stamped with.
+    /// \param state The state of the query, kept up to date by the `::world`.
+    query(const std::atomic<u32>& tick, state& state) noexcept
+        : m_tick(&tick)
+        , m_state(&state)
+    {
+    }
+
+    /// Returns the number of matching entities.
+    ///
+    /// \return The number of matching entities.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_state->ids().size();
+    }
+
+    /// Checks whether no entity matches.
+    ///
+    /// \return Whether no entity matches.
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// Returns the matching entities, in iteration order.
+    ///
+    /// \return A view of the matching entities.
+    [[nodiscard]] std::span<const entity> ids() const noexcept
+    {
+        return m_state->ids();
+    }
+
+    /// Checks whether an `::entity` matches.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` matches; `false` otherwise.
+    [[nodiscard]] bool contains(const entity entity) const noexcept
+    {
+        return m_state->contains(entity);
+    }
+
+    /// Invokes a function on each matching `::entity` and its components.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param fn The function to invoke with the `::entity` followed by a
+    ///     reference to each of its queried components.
+    template <typename Fn>
+    void each(Fn&& fn) const
+    {
+        const std::tuple<collection<T>&...> pools { resolve<T>()... };
+        const u32 tick { m_tick->load(std::memory_order_relaxed) };
+
+        for (const entity entity : m_state->ids()) {
+            fn(entity,
+                get<T>(std::get<collection<T>&>(pools), entity, tick)...);
+        }
+    }
+
+private:
+    /// The component collection of a queried type, constant if the type is.
+    template <typename U>
+    using collection = std::conditional_t<std::is_const_v<U>,
+        const sparse_set<std::remove_const_t<U>>,
+        sparse_set<std::remove_const_t<U>>>;
+
+    /// Returns the component collection of a queried type, for writing only
+    /// if the type is not `const`-qualified.
+    template <typename U>
+    [[nodiscard]] collection<U>& resolve() const
+    {
+        auto& pool { m_state->template pool<std::remove_const_t<U>>() };
+
+        if constexpr (std::is_const_v<U>) {
+            return pool.read();
+        } else {
+            return pool.write();
+        }
+    }
+
+    /// Returns the component of an `::entity`, stamping it as changed if it is
+    /// yielded for writing.
+    template <typename U>
+    [[nodiscard]] static U& get(
+        collection<U>& pool, const entity entity, const u32 tick)
+    {
+        if constexpr (std::is_const_v<U>) {
+            return pool[entity];
+        } else {
+            const auto index { pool.index(entity) };
+            pool.ticks()[index].changed = tick;
+            return pool.data()[index];
+        }
+    }
+
+    const std::atomic<u32>* m_tick;
+    state* m_state;
+};
+
+} // namespace eecs
+
+#endif // !EECS_QUERY_HPP
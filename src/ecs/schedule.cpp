@@ -1,21 +1,195 @@
 #include "schedule.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "access.hpp"
+#include "command_buffer.hpp"
+#include "profiler.hpp"
 #include "system.hpp"
+#include "thread_pool.hpp"
 #include "world.hpp"
 
 namespace eecs {
 
-schedule& schedule::add_system(const system system)
+namespace {
+
+    /// Runs a system, timing it into a `::profiler` if there is one.
+    void run_one(world& world, profiler* profiler, const system& system,
+        const std::string_view name)
+    {
+        if (profiler == nullptr) {
+            system(world);
+            return;
+        }
+
+        using clock = eecs::profiler::clock;
+
+        const clock::time_point start { clock::now() };
+        system(world);
+        profiler->record(name, start, clock::now());
+    }
+
+    /// The state of a single run of a `::schedule` on a `::thread_pool`.
+    class execution {
+    public:
+        execution(world& world, thread_pool& pool,
+            const std::vector<system>& systems,
+            const std::vector<std::string>& names,
+            const std::vector<std::vector<std::size_t>>& dependents,
+            const std::vector<std::size_t>& dependency_counts)
+            : m_world(world)
+            , m_pool(pool)
+            , m_profiler(world.try_resource<profiler>())
+            , m_systems(systems)
+            , m_names(names)
+            , m_dependents(dependents)
+            , m_dependency_counts(dependency_counts)
+            , m_remaining(std::make_unique<std::atomic<std::size_t>[]>(
+                  systems.size()))
+            , m_pending(systems.size())
+        {
+            for (std::size_t i { 0 }; i < systems.size(); ++i) {
+                m_remaining[i] = dependency_counts[i];
+            }
+        }
+
+        /// Runs every system and waits for them to finish.
+        ///
+        /// \throws Any exception thrown by a system.
+        void run()
+        {
+            // Roots are found from the static counts, since the live ones
+            // reach zero as soon as submitted systems finish.
+            for (std::size_t i { 0 }; i < m_systems.size(); ++i) {
+                if (m_dependency_counts[i] == 0) {
+                    submit(i);
+                }
+            }
+
+            m_pool.wait_until([this] { return m_pending == 0; });
+
+            if (m_exception) {
+                std::rethrow_exception(m_exception);
+            }
+        }
+
+    private:
+        void submit(const std::size_t index)
+        {
+            m_pool.submit([this, index] { run_system(index); });
+        }
+
+        // Once a system has thrown, the systems not started yet are skipped
+        // rather than run against a partially updated world, but still
+        // release their dependents so that the run drains.
+        void run_system(const std::size_t index)
+        {
+            if (!m_failed.load(std::memory_order_acquire)) {
+                try {
+                    run_one(
+                        m_world, m_profiler, m_systems[index], m_names[index]);
+                } catch (...) {
+                    const std::lock_guard lock { m_mutex };
+                    if (!m_exception) {
+                        m_exception = std::current_exception();
+                    }
+                    m_failed.store(true, std::memory_order_release);
+                }
+            }
+
+            for (const std::size_t dependent : m_dependents[index]) {
+                if (m_remaining[dependent].fetch_sub(1) == 1) {
+                    submit(dependent);
+                }
+            }
+
+            m_pending.fetch_sub(1);
+        }
+
+        world& m_world;
+        thread_pool& m_pool;
+        profiler* m_profiler;
+        const std::vector<system>& m_systems;
+        const std::vector<std::string>& m_names;
+        const std::vector<std::vector<std::size_t>>& m_dependents;
+        const std::vector<std::size_t>& m_dependency_counts;
+        std::unique_ptr<std::atomic<std::size_t>[]> m_remaining;
+        std::atomic<std::size_t> m_pending;
+        std::atomic<bool> m_failed { false };
+        std::mutex m_mutex;
+        std::exception_ptr m_exception;
+    };
+
+    /// Applies the changes recorded in the `::world`'s `::command_buffer`, if
+    /// it has one.
+    void flush_commands(world& world)
+    {
+        if (auto* commands { world.try_resource<command_buffer>() }) {
+            commands->flush(world);
+        }
+    }
+
+} // namespace
+
+schedule& schedule::add_system(system system, const std::string_view name)
+{
+    return add_system(std::move(system), access {}, name);
+}
+
+schedule& schedule::add_system(
+    system system, access access, const std::string_view name)
 {
-    m_systems.emplace_back(system);
+    const std::size_t index { m_systems.size() };
+
+    m_dependents.emplace_back();
+    m_dependency_counts.push_back(0);
+
+    for (std::size_t i { 0 }; i < index; ++i) {
+        if (m_accesses[i].conflicts_with(access)) {
+            m_dependents[i].push_back(index);
+            ++m_dependency_counts[index];
+        }
+    }
+
+    m_systems.push_back(std::move(system));
+    // Unnamed systems are told apart by position, so that their runs are
+    // not merged in profiles.
+    m_names.push_back(name.empty() ? std::format("system #{}", index)
+                                   : std::string { name });
+    m_accesses.push_back(std::move(access));
     return *this;
 }
 
 void schedule::run(world& world) const
 {
-    for (const system system : m_systems) {
-        system(world);
+    auto* profiler { world.try_resource<eecs::profiler>() };
+    for (std::size_t i { 0 }; i < m_systems.size(); ++i) {
+        run_one(world, profiler, m_systems[i], m_names[i]);
+    }
+
+    flush_commands(world);
+}
+
+void schedule::run(world& world, thread_pool& pool) const
+{
+    for (const access& access : m_accesses) {
+        access.prepare(world);
     }
+
+    execution execution { world, pool, m_systems, m_names, m_dependents,
+        m_dependency_counts };
+    execution.run();
+
+    flush_commands(world);
 }
 
 } // namespace eecs
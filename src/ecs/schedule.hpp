@@ -1,21 +1,100 @@
 #ifndef EECS_SCHEDULE_HPP
 #define EECS_SCHEDULE_HPP
 
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "access.hpp"
 #include "system.hpp"
+#include "system_param.hpp"
+#include "thread_pool.hpp"
 #include "world.hpp"
 
 namespace eecs {
 
+/// An ordered collection of systems.
+///
+/// Systems conflict when their declared `::access`es do. Conflicting systems
+/// always run in the order they were added; others may run concurrently.
+/// Once every system has run, the changes recorded in the `::world`'s
+/// `::command_buffer` resource, if it has one, are applied. If the `::world`
+/// has a `::profiler` resource, each system is timed into it.
 class schedule {
 public:
-    schedule& add_system(system system);
+    /// Adds an exclusive system, which never runs concurrently with any
+    /// other system.
+    ///
+    /// \param system The system to add.
+    /// \param name The name of the system in profiles. If empty, the system
+    ///     is named after its position in the schedule.
+    /// \return A reference to this object.
+    schedule& add_system(system system, std::string_view name = {});
 
+    /// Adds a system that accesses the given components and resources.
+    ///
+    /// \tparam Declarations The `::reads`, `::writes`, `::reads_resource` and
+    ///     `::writes_resource` declarations of the system.
+    /// \param system The system to add.
+    /// \param name The name of the system in profiles. If empty, the system
+    ///     is named after its position in the schedule.
+    /// \return A reference to this object.
+    template <typename... Declarations>
+    schedule& add_system(system system, const std::string_view name = {})
+    {
+        return add_system(
+            std::move(system), access::of<Declarations...>(), name);
+    }
+
+    /// Adds a system whose parameters are resolved from the `::world`, such
+    /// as `::view`s, `::res`ources and the `::command_buffer`, see
+    /// `::system_param`. The system's `::access` is derived from them.
+    ///
+    /// \tparam Fn The type of system.
+    /// \param fn The system to add.
+    /// \param name The name of the system in profiles. If empty, the system
+    ///     is named after its position in the schedule.
+    /// \return A reference to this object.
+    template <typename Fn>
+        requires(!std::is_invocable_v<Fn&, world&>)
+    schedule& add_system(Fn fn, const std::string_view name = {})
+    {
+        using param_system = eecs::param_system<Fn>;
+        return add_system(param_system { std::move(fn) },
+            param_system::implied_access(), name);
+    }
+
+    /// Adds a system with the given access.
+    ///
+    /// \param system The system to add.
+    /// \param access The components and resources the system accesses.
+    /// \param name The name of the system in profiles. If empty, the system
+    ///     is named after its position in the schedule.
+    /// \return A reference to this object.
+    schedule& add_system(
+        system system, access access, std::string_view name = {});
+
+    /// Runs every system sequentially, in the order they were added.
+    ///
+    /// \param world The `::world` to run the systems on.
     void run(world& world) const;
 
+    /// Runs every system on a `::thread_pool`, running systems that do not
+    /// conflict concurrently.
+    ///
+    /// \param world The `::world` to run the systems on.
+    /// \param pool The `::thread_pool` to run the systems on.
+    void run(world& world, thread_pool& pool) const;
+
 private:
     std::vector<system> m_systems;
+    std::vector<std::string> m_names;
+    std::vector<access> m_accesses;
+    std::vector<std::vector<std::size_t>> m_dependents;
+    std::vector<std::size_t> m_dependency_counts;
 };
 
 } // namespace eecs
@@ -0,0 +1,383 @@
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+#include "world.hpp"
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace eecs {
+
+namespace {
+
+    /// Identifies a file as an image.
+    constexpr u64 magic { 0x50414e5353434545 }; // "EECSSNAP"
+
+    /// The version of the image layout, bumped whenever it or the layout of
+    /// an `::entity` changes.
+    constexpr u32 version { 2 };
+
+    /// The first bytes of an image.
+    struct image_header {
+        u64 magic;
+        u32 version;
+        u32 section_count;
+        u64 entities_offset;
+        u32 entity_count;
+        entity free_index;
+    };
+
+    static_assert(id_traits<entity>::index_bits
+            <= std::numeric_limits<u32>::digits,
+        "The entity count of an image must hold any index");
+
+    /// Describes the components of one type in an image.
+    struct image_section {
+        u64 key;
+        u32 size;
+        u32 count;
+        u64 ids_offset;
+        u64 values_offset;
+    };
+
+    /// Rounds `offset` up to a multiple of the section alignment.
+    constexpr std::size_t align_up(const std::size_t offset) noexcept
+    {
+        return (offset + snapshot::section_alignment - 1)
+            & ~(snapshot::section_alignment - 1);
+    }
+
+    /// Copies a trivially copyable object out of an image, checking that it
+    /// lies within the image.
+    template <typename T>
+    T read(const std::span<const std::byte> image, const std::size_t offset)
+    {
+        if (offset > image.size() || image.size() - offset < sizeof(T)) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+
+        T value;
+        std::memcpy(&value, image.data() + offset, sizeof(T));
+        return value;
+    }
+
+    /// Returns the `count` bytes of an image at `offset`, checking that they
+    /// lie within the image.
+    std::span<const std::byte> slice(const std::span<const std::byte> image,
+        const u64 offset, const u64 count)
+    {
+        if (offset > image.size() || image.size() - offset < count) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+
+        return image.subspan(offset, count);
+    }
+
+    /// Writes an image to a file.
+    void write_file(const std::filesystem::path& path,
+        const std::span<const std::byte> image)
+    {
+        std::ofstream file { path, std::ios::binary | std::ios::trunc };
+        file.write(reinterpret_cast<const char*>(image.data()),
+            static_cast<std::streamsize>(image.size()));
+
+        if (!file) {
+            throw std::runtime_error("Failed to write snapshot");
+        }
+    }
+
+    /// A read-only view of the contents of a file, mapped into memory where
+    /// supported.
+    class mapped_file {
+    public:
+        explicit mapped_file(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            std::ifstream file { path, std::ios::binary };
+            if (!file) {
+                throw std::runtime_error("Failed to open snapshot");
+            }
+
+            m_buffer.assign(std::istreambuf_iterator<char> { file },
+                std::istreambuf_iterator<char> {});
+            m_data = std::as_bytes(std::span { m_buffer });
+#else
+            const int descriptor { ::open(path.c_str(), O_RDONLY) };
+            if (descriptor < 0) {
+                throw std::runtime_error("Failed to open snapshot");
+            }
+
+            struct stat status { };
+            if (::fstat(descriptor, &status) != 0) {
+                ::close(descriptor);
+                throw std::runtime_error("Failed to open snapshot");
+            }
+
+            const auto size { static_cast<std::size_t>(status.st_size) };
+            void* address { size == 0 ? nullptr
+                                       : ::mmap(nullptr, size, PROT_READ,
+                                             MAP_PRIVATE, descriptor, 0) };
+            ::close(descriptor);
+
+            if (address == MAP_FAILED) {
+                throw std::runtime_error("Failed to map snapshot");
+            }
+
+            m_data = { static_cast<const std::byte*>(address), size };
+#endif
+        }
+
+        mapped_file(const mapped_file& other) = delete;
+        mapped_file(mapped_file&& other) noexcept = delete;
+        mapped_file& operator=(const mapped_file& other) = delete;
+        mapped_file& operator=(mapped_file&& other) noexcept = delete;
+
+        ~mapped_file()
+        {
+#if !defined(_WIN32)
+            if (!m_data.empty()) {
+                ::munmap(const_cast<std::byte*>(m_data.data()), m_data.size());
+            }
+#endif
+        }
+
+        [[nodiscard]] std::span<const std::byte> data() const noexcept
+        {
+            return m_data;
+        }
+
+    private:
+#if defined(_WIN32)
+        std::vector<char> m_buffer;
+#endif
+        std::span<const std::byte> m_data;
+    };
+
+} // namespace
+
+std::vector<std::byte> snapshot::capture(const world& world) const
+{
+    return capture(world.freeze());
+}
+
+std::vector<std::byte> snapshot::capture(const frozen_world& world) const
+{
+    std::vector<pool_data> pools;
+    pools.reserve(m_entries.size());
+    for (const entry& entry : m_entries) {
+        pools.push_back(entry.pool(world));
+    }
+
+    std::vector<image_section> sections(m_entries.size());
+    std::size_t offset { align_up(
+        sizeof(image_header) + sizeof(image_section) * sections.size()) };
+
+    const u64 entities_offset { offset };
+    offset = align_up(offset + sizeof(entity) * world.m_entities.size());
+
+    for (std::size_t i { 0 }; i < sections.size(); ++i) {
+        const std::size_t count { pools[i].ids.size() };
+        sections[i].key = m_entries[i].key;
+        sections[i].size = m_entries[i].size;
+        sections[i].count = static_cast<u32>(count);
+        sections[i].ids_offset = offset;
+        offset = align_up(offset + sizeof(entity) * count);
+        sections[i].values_offset = offset;
+        offset = align_up(offset + std::size_t { m_entries[i].size } * count);
+    }
+
+    std::vector<std::byte> image(offset);
+    const image_header header {
+        .magic = magic,
+        .version = version,
+        .section_count = static_cast<u32>(sections.size()),
+        .entities_offset = entities_offset,
+        .entity_count = static_cast<u32>(world.m_entities.size()),
+        .free_index = world.m_free_index,
+    };
+
+    std::memcpy(image.data(), &header, sizeof(image_header));
+    if (!sections.empty()) {
+        std::memcpy(image.data() + sizeof(image_header), sections.data(),
+            sizeof(image_section) * sections.size());
+    }
+    if (!world.m_entities.empty()) {
+        std::memcpy(image.data() + entities_offset, world.m_entities.data(),
+            sizeof(entity) * world.m_entities.size());
+    }
+
+    for (std::size_t i { 0 }; i < sections.size(); ++i) {
+        if (sections[i].count == 0) {
+            continue;
+        }
+
+        std::memcpy(image.data() + sections[i].ids_offset,
+            pools[i].ids.data(), sizeof(entity) * sections[i].count);
+        std::memcpy(image.data() + sections[i].values_offset, pools[i].values,
+            std::size_t { sections[i].size } * sections[i].count);
+    }
+
+    return image;
+}
+
+void snapshot::restore(
+    world& world, const std::span<const std::byte> image) const
+{
+    world.clear();
+
+    try {
+        const auto header { read<image_header>(image, 0) };
+        if (header.magic != magic || header.version != version) {
+            throw std::runtime_error("Not a snapshot");
+        }
+
+        const std::span<const std::byte> entities { slice(image,
+            header.entities_offset,
+            u64 { sizeof(entity) } * header.entity_count) };
+        world.m_entities.resize(header.entity_count);
+        if (!entities.empty()) {
+            std::memcpy(
+                world.m_entities.data(), entities.data(), entities.size());
+        }
+        world.m_free_index = header.free_index;
+        world.m_size = static_cast<std::size_t>(std::ranges::count_if(
+            std::views::iota(u32 { 0 }, header.entity_count),
+            [&world](const u32 index) {
+                return id_traits<entity>::to_index(world.m_entities[index])
+                    == index;
+            }));
+
+        // The free list must chain every destroyed index exactly once: an
+        // alive index links to itself, so any cycle is caught by the length.
+        u64 free_count { 0 };
+        for (entity index { header.free_index };
+            index != id_traits<entity>::index_mask;
+            index = id_traits<entity>::to_index(world.m_entities[index])) {
+            if (index >= header.entity_count
+                || ++free_count > header.entity_count) {
+                throw std::runtime_error("Invalid free list");
+            }
+        }
+        if (world.m_size + free_count != header.entity_count) {
+            throw std::runtime_error("Invalid free list");
+        }
+
+        for (u32 i { 0 }; i < header.section_count; ++i) {
+            const auto section { read<image_section>(
+                image, sizeof(image_header) + sizeof(image_section) * i) };
+
+            const entry* entry { nullptr };
+            for (const auto& candidate : m_entries) {
+                if (candidate.key == section.key) {
+                    entry = &candidate;
+                }
+            }
+
+            if (entry == nullptr || section.count == 0) {
+                continue;
+            }
+
+            if (entry->size != section.size) {
+                throw std::runtime_error("Mismatched component size");
+            }
+
+            const std::span<const std::byte> ids { slice(image,
+                section.ids_offset, u64 { sizeof(entity) } * section.count) };
+            const std::span<const std::byte> values { slice(image,
+                section.values_offset, u64 { section.size } * section.count) };
+
+            std::vector<entity> copy(section.count);
+            std::memcpy(copy.data(), ids.data(), ids.size());
+            for (const entity entity : copy) {
+                if (!world.valid(entity)) {
+                    throw std::runtime_error("Component of a dead entity");
+                }
+            }
+
+            entry->restore(world, copy, values.data());
+        }
+    } catch (...) {
+        world.clear();
+        throw;
+    }
+}
+
+void snapshot::save(
+    const world& world, const std::filesystem::path& path) const
+{
+    write_file(path, capture(world));
+}
+
+std::future<void> snapshot::save(const world& world,
+    const std::filesystem::path& path, thread_pool& pool) const
+{
+    auto frozen { std::make_shared<frozen_world>(world.freeze()) };
+    auto promise { std::make_shared<std::promise<void>>() };
+    std::future<void> future { promise->get_future() };
+
+    pool.submit([self = *this, frozen, promise, path] {
+        try {
+            write_file(path, self.capture(*frozen));
+            promise->set_value();
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return future;
+}
+
+void snapshot::load(world& world, const std::filesystem::path& path) const
+{
+    const mapped_file file { path };
+    restore(world, file.data());
+}
+
+u64 snapshot::key_of(const std::string_view name) noexcept
+{
+    // 64-bit FNV-1a.
+    u64 hash { 0xcbf29ce484222325 };
+    for (const char character : name) {
+        hash ^= static_cast<unsigned char>(character);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+void snapshot::add(entry entry)
+{
+    for (const auto& existing : m_entries) {
+        if (existing.key == entry.key) {
+            throw std::logic_error("Component name is already registered");
+        }
+    }
+
+    m_entries.push_back(entry);
+}
+
+} // namespace eecs
@@ -0,0 +1,168 @@
+#ifndef EECS_SNAPSHOT_HPP
+#define EECS_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "entity.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+#include "world.hpp"
+
+namespace eecs {
+
+/// A binary image of the entities and components of a `::world`.
+///
+/// Only registered types of components are saved. Each is identified in the
+/// image by a name rather than by its per-process type identifier, and its
+/// identifiers and values are laid out as two contiguous, aligned sections
+/// that are copied with a single `memcpy` each. Files are loaded through a
+/// memory mapping, so only the pages that are read are brought in.
+///
+/// Resources are not saved. Loaded components count as inserted during the
+/// `::world`'s current tick.
+class snapshot {
+public:
+    /// The alignment, in bytes, of every section of an image.
+    static constexpr std::size_t section_alignment { 64 };
+
+    /// Registers a type of component to save and load.
+    ///
+    /// \tparam T The type of component. Must be trivially copyable.
+    /// \param name The name that identifies the type in images. Must be
+    ///     unique and stay the same across builds that share images.
+    /// \return A reference to this object.
+    /// \throws std::logic_error if the name is already registered.
+    template <typename T>
+    snapshot& component(const std::string_view name)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "Saved components must be trivially copyable");
+        static_assert(alignof(T) <= section_alignment,
+            "Saved components must not be over-aligned");
+
+        add(entry {
+            .key = key_of(name),
+            .size = sizeof(T),
+            .pool = &snapshot::pool_of<T>,
+            .restore = &snapshot::restore_pool<T>,
+        });
+        return *this;
+    }
+
+    /// Captures an image of a `::world` in memory.
+    ///
+    /// \param world The `::world` to capture.
+    /// \return The image.
+    [[nodiscard]] std::vector<std::byte> capture(const world& world) const;
+
+    /// Captures an image of a frozen `::world` in memory. May be called on
+    /// any thread.
+    ///
+    /// \param world The frozen `::world` to capture.
+    /// \return The image.
+    [[nodiscard]] std::vector<std::byte> capture(
+        const frozen_world& world) const;
+
+    /// Replaces the entities and components of a `::world` with those of an
+    /// image. Sections of unregistered types are skipped.
+    ///
+    /// \param world The `::world` to restore.
+    /// \param image The image to restore from.
+    /// \throws std::runtime_error if the image is malformed, in which case
+    ///     the `::world` is left empty.
+    void restore(world& world, std::span<const std::byte> image) const;
+
+    /// Saves an image of a `::world` to a file.
+    ///
+    /// \param world The `::world` to save.
+    /// \param path The path of the file to write.
+    /// \throws std::runtime_error if the file cannot be written.
+    void save(const world& world, const std::filesystem::path& path) const;
+
+    /// Freezes a `::world`, then captures an image of it and writes it to a
+    /// file on a `::thread_pool`, so that the caller is not stalled.
+    ///
+    /// \param world The `::world` to save.
+    /// \param path The path of the file to write.
+    /// \param pool The `::thread_pool` to write on. Must have workers, or be
+    ///     waited on before the returned future.
+    /// \return A future that becomes ready once the file is written, and
+    ///     holds the exception thrown if it could not be.
+    [[nodiscard]] std::future<void> save(const world& world,
+        const std::filesystem::path& path, thread_pool& pool) const;
+
+    /// Replaces the entities and components of a `::world` with those saved
+    /// in a file.
+    ///
+    /// \param world The `::world` to load into.
+    /// \param path The path of the file to read.
+    /// \throws std::runtime_error if the file cannot be read or is malformed.
+    void load(world& world, const std::filesystem::path& path) const;
+
+private:
+    /// The identifiers and raw values of a component collection.
+    struct pool_data {
+        std::span<const entity> ids;
+        const std::byte* values;
+    };
+
+    /// A registered type of component.
+    struct entry {
+        u64 key;
+        u32 size;
+        pool_data (*pool)(const frozen_world& world);
+        void (*restore)(
+            world& world, std::span<const entity> ids, const std::byte* values);
+    };
+
+    template <typename T>
+    static pool_data pool_of(const frozen_world& world)
+    {
+        const sparse_set<T>* components { world.components<T>() };
+        if (components == nullptr) {
+            return pool_data { .ids = {}, .values = nullptr };
+        }
+
+        return pool_data {
+            .ids = components->ids(),
+            .values = reinterpret_cast<const std::byte*>(components->data()),
+        };
+    }
+
+    template <typename T>
+    static void restore_pool(
+        world& world, std::span<const entity> ids, const std::byte* values)
+    {
+        // Images in memory may be less aligned than their sections.
+        if (reinterpret_cast<std::uintptr_t>(values) % alignof(T) != 0) {
+            std::vector<T> copy(ids.size());
+            std::memcpy(copy.data(), values, ids.size() * sizeof(T));
+            world.insert<T>(ids, copy);
+            return;
+        }
+
+        world.insert<T>(ids,
+            std::span { reinterpret_cast<const T*>(values), ids.size() });
+    }
+
+    /// Returns the key that identifies a name in images.
+    [[nodiscard]] static u64 key_of(std::string_view name) noexcept;
+
+    /// Registers a type of component.
+    void add(entry entry);
+
+    std::vector<entry> m_entries;
+};
+
+} // namespace eecs
+
+#endif // !EECS_SNAPSHOT_HPP
@@ -1,27 +1,120 @@
 #ifndef EECS_SPARSE_SET_HPP
 #define EECS_SPARSE_SET_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "entity.hpp"
 #include "types.hpp"
 
 namespace eecs {
 
+/// The ticks at which an element was inserted and last changed.
+struct change_ticks {
+    u32 added { 0 };
+    u32 changed { 0 };
+};
+
+/// A function notified of a change to the element of an identifier in a
+/// `::sparse_set`, along with the context it was connected with.
+///
+/// \tparam IdType The unsigned integral type of the identifiers.
+template <std::unsigned_integral IdType>
+struct sparse_set_hook {
+    void (*fn)(void* context, IdType id);
+    void* context;
+};
+
+/// An associative container that maps identifiers to densely packed values.
+///
+/// The sparse side is split into fixed-size pages that are allocated on
+/// demand, so memory use is proportional to the ranges of identifiers in use
+/// rather than to the largest identifier.
+///
+/// Identifiers are split into an index and a version by `::id_traits`. Only
+/// the index selects a slot in the sparse array, so at most one version of an
+/// index has an element: lookups of another version miss, and inserting one
+/// replaces the element of the version already there.
+///
+/// Alongside each value, the container keeps the `::change_ticks` of when it
+/// was inserted and last overwritten, stamped with the tick given to
+/// `set_tick()`.
+///
+/// Hooks can be connected to be notified when an element is inserted for an
+/// identifier, overwritten, or erased. A container without hooks only pays
+/// for checking that there are none. Copies keep the hooks of the original,
+/// so that a copy-on-write copy stays observed.
+///
+/// \tparam T The type of the values.
+/// \tparam IdType The unsigned integral type of the identifiers.
 template <typename T, std::unsigned_integral IdType = u32>
 class sparse_set {
 public:
     using value_type = T;
     using id_type = IdType;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
     using reference = value_type&;
     using const_reference = const value_type&;
     using iterator = typename std::vector<value_type>::iterator;
     using const_iterator = typename std::vector<value_type>::const_iterator;
 
+    /// The number of identifiers covered by each page of the sparse array.
+    static constexpr std::size_t page_size { 4096 };
+
+    using hook = sparse_set_hook<id_type>;
+
+    sparse_set() = default;
+
+    /// Constructs a `::sparse_set` by copying the contents of another one.
+    ///
+    /// \param other The object to copy from.
+    sparse_set(const sparse_set& other)
+        : m_dense_ids(other.m_dense_ids)
+        , m_dense_values(other.m_dense_values)
+        , m_dense_ticks(other.m_dense_ticks)
+        , m_tick(other.m_tick)
+        , m_on_insert(other.m_on_insert)
+        , m_on_update(other.m_on_update)
+        , m_on_erase(other.m_on_erase)
+    {
+        copy_pages(other);
+    }
+
+    sparse_set(sparse_set&& other) noexcept = default;
+
+    /// Copies the contents of another `::sparse_set` into this one.
+    ///
+    /// \param other The object to copy from.
+    /// \return A reference to this object.
+    sparse_set& operator=(const sparse_set& other)
+    {
+        if (&other != this) {
+            m_dense_ids = other.m_dense_ids;
+            m_dense_values = other.m_dense_values;
+            m_dense_ticks = other.m_dense_ticks;
+            m_tick = other.m_tick;
+            m_on_insert = other.m_on_insert;
+            m_on_update = other.m_on_update;
+            m_on_erase = other.m_on_erase;
+            copy_pages(other);
+        }
+
+        return *this;
+    }
+
+    sparse_set& operator=(sparse_set&& other) noexcept = default;
+
+    ~sparse_set() = default;
+
     /// Returns a reference to the value that `id` maps to.
     ///
     /// \param id The `id` of the element to find.
@@ -30,7 +123,7 @@ public:
     {
         assert(id != s_tombstone);
         assert(contains(id));
-        return m_dense_values[m_sparse[id]];
+        return m_dense_values[sparse_ref(id)];
     }
 
     /// Returns a constant reference to the value that `id` maps to.
@@ -41,7 +134,7 @@ public:
     {
         assert(id != s_tombstone);
         assert(contains(id));
-        return m_dense_values[m_sparse[id]];
+        return m_dense_values[sparse_ref(id)];
     }
 
     /// Returns an iterator to the first element of this container.
@@ -74,22 +167,75 @@ public:
     /// \return The size of the container.
     [[nodiscard]] id_type size() const noexcept { return m_dense_ids.size(); }
 
+    /// Reserves room in the densely packed arrays for at least `capacity`
+    /// elements.
+    ///
+    /// \param capacity The number of elements to reserve room for.
+    void reserve(const std::size_t capacity)
+    {
+        m_dense_ids.reserve(capacity);
+        m_dense_values.reserve(capacity);
+        m_dense_ticks.reserve(capacity);
+    }
+
     void insert(const id_type id, const value_type& value)
     {
         assert(id != s_tombstone);
 
         if (contains(id)) {
-            m_dense_values[m_sparse[id]] = value;
-            return;
-        }
+            m_dense_values[sparse_ref(id)] = value;
+            m_dense_ticks[sparse_ref(id)].changed = m_tick;
 
-        if (id >= m_sparse.size()) {
-            m_sparse.resize(id + 1, s_tombstone);
+            if (!m_on_update.empty()) {
+                notify(m_on_update, id);
+            }
+
+            return;
         }
 
-        m_sparse[id] = m_dense_ids.size();
+        erase_other_version(id);
+        assure_page(id) = m_dense_ids.size();
         m_dense_ids.push_back(id);
         m_dense_values.push_back(value);
+        m_dense_ticks.push_back({ .added = m_tick, .changed = m_tick });
+
+        if (!m_on_insert.empty()) {
+            notify(m_on_insert, id);
+        }
+    }
+
+    /// Inserts an element for each identifier in `[first, last)`, taking the
+    /// values in order from `values`. Overwrites the values that identifiers
+    /// already map to.
+    ///
+    /// Room for every element and the pages they map to are allocated up
+    /// front, so that inserting many elements reallocates at most once.
+    ///
+    /// \tparam It The type of the iterators over the identifiers.
+    /// \tparam ValueIt The type of the iterator over the values.
+    /// \param first The first identifier.
+    /// \param last One past the last identifier.
+    /// \param values The first value.
+    template <std::forward_iterator It, std::input_iterator ValueIt>
+    void insert(It first, const It last, ValueIt values)
+    {
+        const std::size_t required { m_dense_ids.size()
+            + static_cast<std::size_t>(std::distance(first, last)) };
+        if (required > m_dense_ids.capacity()) {
+            reserve(std::max(required, m_dense_ids.capacity() * 2));
+        }
+
+        id_type max_id { 0 };
+        for (It it { first }; it != last; ++it) {
+            max_id = std::max(max_id, to_index(*it));
+        }
+        if (first != last && max_id / page_size >= m_sparse.size()) {
+            m_sparse.resize(max_id / page_size + 1);
+        }
+
+        for (; first != last; ++first, ++values) {
+            insert(*first, *values);
+        }
     }
 
     /// Inserts a new element into the container constructed in-place with the
@@ -105,18 +251,29 @@ public:
         assert(id != s_tombstone);
 
         if (contains(id)) {
-            reference value = m_dense_values[m_sparse[id]];
+            reference value = m_dense_values[sparse_ref(id)];
             value = value_type(std::forward<Args>(args)...);
+            m_dense_ticks[sparse_ref(id)].changed = m_tick;
+
+            if (!m_on_update.empty()) {
+                notify(m_on_update, id);
+            }
+
             return value;
         }
 
-        if (id >= m_sparse.size()) {
-            m_sparse.resize(id + 1, s_tombstone);
+        erase_other_version(id);
+        assure_page(id) = m_dense_ids.size();
+        m_dense_ids.push_back(id);
+        reference value { m_dense_values.emplace_back(
+            std::forward<Args>(args)...) };
+        m_dense_ticks.push_back({ .added = m_tick, .changed = m_tick });
+
+        if (!m_on_insert.empty()) {
+            notify(m_on_insert, id);
         }
 
-        m_sparse[id] = m_dense_ids.size();
-        m_dense_ids.push_back(id);
-        m_dense_values.emplace_back(std::forward<Args>(args)...);
+        return value;
     }
 
     /// Removes the element (if one exists) with the identifier equivalent to
@@ -131,18 +288,53 @@ public:
             return;
         }
 
-        const id_type dense_id { m_sparse[id] };
+        if (!m_on_erase.empty()) {
+            notify(m_on_erase, id);
+        }
+
+        const id_type dense_id { sparse_ref(id) };
 
         std::swap(m_dense_ids[dense_id], m_dense_ids.back());
         std::swap(m_dense_values[dense_id], m_dense_values.back());
+        std::swap(m_dense_ticks[dense_id], m_dense_ticks.back());
+
+        sparse_ref(m_dense_ids[dense_id]) = dense_id;
+        sparse_ref(id) = s_tombstone;
 
         m_dense_ids.pop_back();
         m_dense_values.pop_back();
-
-        m_sparse[m_dense_ids[dense_id]] = dense_id;
-        m_sparse[id] = s_tombstone;
+        m_dense_ticks.pop_back();
     };
 
+    /// Removes the elements (if they exist) with the identifiers in
+    /// `[first, last)`.
+    ///
+    /// \tparam It The type of the iterators over the identifiers.
+    /// \param first The first identifier.
+    /// \param last One past the last identifier.
+    template <std::input_iterator It>
+    void erase(It first, const It last) noexcept
+    {
+        for (; first != last; ++first) {
+            erase(*first);
+        }
+    }
+
+    /// Removes every element from the container.
+    void clear() noexcept
+    {
+        if (!m_on_erase.empty()) {
+            for (const id_type id : m_dense_ids) {
+                notify(m_on_erase, id);
+            }
+        }
+
+        m_sparse.clear();
+        m_dense_ids.clear();
+        m_dense_values.clear();
+        m_dense_ticks.clear();
+    }
+
     /// Checks if there is an element with an identifier equivalent to `id` in
     /// the container.
     ///
@@ -152,20 +344,336 @@ public:
     {
         assert(id != s_tombstone);
 
-        if (id >= m_sparse.size()) {
-            return false;
+        const id_type* dense_id { sparse_ptr(id) };
+        return dense_id != nullptr && *dense_id != s_tombstone
+            && m_dense_ids[*dense_id] == id;
+    };
+
+    /// Returns a pointer to the value that `id` maps to, if one exists.
+    ///
+    /// Unlike a `contains()` check followed by `operator[]`, this performs a
+    /// single lookup into the sparse array.
+    ///
+    /// \param id The `id` of the element to find.
+    /// \return A pointer to the mapped value, or `nullptr` if there is none.
+    [[nodiscard]] pointer find(const id_type id) noexcept
+    {
+        assert(id != s_tombstone);
+
+        const id_type* dense_id { sparse_ptr(id) };
+        if (dense_id == nullptr || *dense_id == s_tombstone
+            || m_dense_ids[*dense_id] != id) {
+            return nullptr;
         }
 
-        const id_type dense_id { m_sparse[id] };
-        return dense_id != s_tombstone && m_dense_ids[dense_id] == id;
-    };
+        return &m_dense_values[*dense_id];
+    }
+
+    /// Returns a pointer to the constant value that `id` maps to, if one
+    /// exists.
+    ///
+    /// \param id The `id` of the element to find.
+    /// \return A pointer to the mapped value, or `nullptr` if there is none.
+    [[nodiscard]] const_pointer find(const id_type id) const noexcept
+    {
+        return const_cast<sparse_set*>(this)->find(id);
+    }
+
+    /// Returns the position of the element that `id` maps to within the
+    /// densely packed arrays.
+    ///
+    /// \param id The `id` of the element to find.
+    /// \return The position of the mapped element.
+    [[nodiscard]] id_type index(const id_type id) const noexcept
+    {
+        assert(contains(id));
+        return sparse_ref(id);
+    }
+
+    /// Swaps the positions of two elements within the densely packed arrays.
+    ///
+    /// \param lhs The `id` of the first element.
+    /// \param rhs The `id` of the second element.
+    void swap_elements(const id_type lhs, const id_type rhs) noexcept
+    {
+        assert(contains(lhs));
+        assert(contains(rhs));
+
+        const id_type lhs_dense_id { sparse_ref(lhs) };
+        const id_type rhs_dense_id { sparse_ref(rhs) };
+
+        swap_dense(lhs_dense_id, rhs_dense_id);
+
+        sparse_ref(lhs) = rhs_dense_id;
+        sparse_ref(rhs) = lhs_dense_id;
+    }
+
+    /// Sorts the elements of this container by their values. Elements that
+    /// compare equal keep their relative order.
+    ///
+    /// Invalidates references to the values. A collection owned by a `::group`
+    /// must not be sorted.
+    ///
+    /// \tparam Compare The type of the comparison function.
+    /// \param compare The function that returns whether its first value is
+    ///     ordered before its second one.
+    template <typename Compare>
+    void sort(Compare compare)
+    {
+        std::vector<id_type> order(m_dense_ids.size());
+        for (id_type i { 0 }; i < order.size(); ++i) {
+            order[i] = i;
+        }
+
+        std::ranges::stable_sort(
+            order, [this, &compare](const id_type lhs, const id_type rhs) {
+                return compare(std::as_const(m_dense_values[lhs]),
+                    std::as_const(m_dense_values[rhs]));
+            });
+
+        // Each position is filled by following the cycle of positions whose
+        // elements must move, so every element is swapped into place once.
+        for (id_type first { 0 }; first < order.size(); ++first) {
+            id_type current { first };
+            id_type next { order[current] };
+
+            while (next != first) {
+                swap_dense(current, next);
+                order[current] = current;
+                current = next;
+                next = order[current];
+            }
+
+            order[current] = current;
+        }
+
+        for (id_type i { 0 }; i < m_dense_ids.size(); ++i) {
+            sparse_ref(m_dense_ids[i]) = i;
+        }
+    }
+
+    /// Sorts the elements of this container in the order of another
+    /// container. Elements whose identifiers are also in the other container
+    /// come first, in its order, followed by the remaining elements.
+    ///
+    /// Invalidates references to the values. A collection owned by a `::group`
+    /// must not be sorted.
+    ///
+    /// \tparam U The type of the values of the other container.
+    /// \param other The container whose order to match.
+    template <typename U>
+    void sort_as(const sparse_set<U, id_type>& other) noexcept
+    {
+        id_type position { 0 };
+
+        for (const id_type id : other.ids()) {
+            if (position == size()) {
+                break;
+            }
+
+            if (contains(id)) {
+                swap_elements(m_dense_ids[position], id);
+                ++position;
+            }
+        }
+    }
+
+    /// Returns a pointer to the densely packed values.
+    ///
+    /// \return A pointer to the first value.
+    [[nodiscard]] pointer data() noexcept { return m_dense_values.data(); }
+
+    /// Returns a pointer to the densely packed constant values.
+    ///
+    /// \return A pointer to the first value.
+    [[nodiscard]] const_pointer data() const noexcept
+    {
+        return m_dense_values.data();
+    }
+
+    /// Returns the identifiers of the elements in this container, in the same
+    /// order as the values.
+    ///
+    /// \return A view of the densely packed identifiers.
+    [[nodiscard]] std::span<const id_type> ids() const noexcept
+    {
+        return m_dense_ids;
+    }
+
+    /// Returns the `::change_ticks` of the elements in this container, in the
+    /// same order as the values.
+    ///
+    /// \return A view of the densely packed ticks.
+    [[nodiscard]] std::span<change_ticks> ticks() noexcept
+    {
+        return m_dense_ticks;
+    }
+
+    /// Returns the constant `::change_ticks` of the elements in this
+    /// container, in the same order as the values.
+    ///
+    /// \return A view of the densely packed ticks.
+    [[nodiscard]] std::span<const change_ticks> ticks() const noexcept
+    {
+        return m_dense_ticks;
+    }
+
+    /// Returns the tick that inserted and overwritten elements are stamped
+    /// with.
+    ///
+    /// \return The current tick.
+    [[nodiscard]] u32 tick() const noexcept { return m_tick; }
+
+    /// Sets the tick that inserted and overwritten elements are stamped with.
+    ///
+    /// \param tick The new tick.
+    void set_tick(const u32 tick) noexcept { m_tick = tick; }
+
+    /// Connects a hook notified after an element is inserted for an
+    /// identifier that had none. Overwriting a value does not notify it.
+    ///
+    /// \param hook The hook to connect.
+    void on_insert(const hook hook) { m_on_insert.push_back(hook); }
+
+    /// Connects a hook notified after the value of an element is overwritten
+    /// by `insert()` or `emplace()`. Writes through references to the values
+    /// do not notify it.
+    ///
+    /// \param hook The hook to connect.
+    void on_update(const hook hook) { m_on_update.push_back(hook); }
+
+    /// Connects a hook notified before an element is erased, including by
+    /// `clear()`. The hook must not throw.
+    ///
+    /// \param hook The hook to connect.
+    void on_erase(const hook hook) { m_on_erase.push_back(hook); }
+
+    /// Disconnects every hook connected with the given context.
+    ///
+    /// \param context The context the hooks were connected with.
+    void disconnect(const void* context) noexcept
+    {
+        const auto connected_with { [context](const hook& hook) {
+            return hook.context == context;
+        } };
+        std::erase_if(m_on_insert, connected_with);
+        std::erase_if(m_on_update, connected_with);
+        std::erase_if(m_on_erase, connected_with);
+    }
 
 private:
     static constexpr id_type s_tombstone = std::numeric_limits<id_type>().max();
 
-    std::vector<id_type> m_sparse;
+    /// Returns the position in the sparse array that `id` maps to. Only the
+    /// index bits of an identifier are used, so that recycled identifiers
+    /// reuse the same slot.
+    [[nodiscard]] static constexpr id_type to_index(const id_type id) noexcept
+    {
+        return id_traits<id_type>::to_index(id);
+    }
+
+    /// Returns a pointer to the slot in the sparse array that `id` maps to,
+    /// or `nullptr` if its page has not been allocated.
+    [[nodiscard]] const id_type* sparse_ptr(const id_type id) const noexcept
+    {
+        const std::size_t page { to_index(id) / page_size };
+
+        if (page >= m_sparse.size() || m_sparse[page] == nullptr) {
+            return nullptr;
+        }
+
+        return &m_sparse[page][to_index(id) % page_size];
+    }
+
+    /// Returns a reference to the slot in the sparse array that `id` maps to.
+    /// Its page must have been allocated.
+    [[nodiscard]] id_type& sparse_ref(const id_type id) noexcept
+    {
+        assert(sparse_ptr(id) != nullptr);
+        return m_sparse[to_index(id) / page_size][to_index(id) % page_size];
+    }
+
+    /// Returns the slot in the sparse array that `id` maps to. Its page must
+    /// have been allocated.
+    [[nodiscard]] id_type sparse_ref(const id_type id) const noexcept
+    {
+        assert(sparse_ptr(id) != nullptr);
+        return m_sparse[to_index(id) / page_size][to_index(id) % page_size];
+    }
+
+    /// Erases the element of another version of `id`, if any, which would
+    /// otherwise be orphaned when `id` takes over its slot.
+    void erase_other_version(const id_type id) noexcept
+    {
+        const id_type* dense_id { sparse_ptr(id) };
+
+        if (dense_id != nullptr && *dense_id != s_tombstone) {
+            erase(m_dense_ids[*dense_id]);
+        }
+    }
+
+    /// Invokes each of the given hooks with an identifier.
+    static void notify(const std::vector<hook>& hooks, const id_type id)
+    {
+        for (const hook& hook : hooks) {
+            hook.fn(hook.context, id);
+        }
+    }
+
+    /// Swaps the elements at two positions of the densely packed arrays,
+    /// leaving the sparse array untouched.
+    void swap_dense(const id_type lhs, const id_type rhs) noexcept
+    {
+        using std::swap;
+        swap(m_dense_ids[lhs], m_dense_ids[rhs]);
+        swap(m_dense_values[lhs], m_dense_values[rhs]);
+        swap(m_dense_ticks[lhs], m_dense_ticks[rhs]);
+    }
+
+    /// Returns a reference to the slot in the sparse array that `id` maps to,
+    /// allocating its page if needed.
+    id_type& assure_page(const id_type id)
+    {
+        const std::size_t page { to_index(id) / page_size };
+
+        if (page >= m_sparse.size()) {
+            m_sparse.resize(page + 1);
+        }
+
+        if (m_sparse[page] == nullptr) {
+            m_sparse[page]
+                = std::make_unique_for_overwrite<id_type[]>(page_size);
+            std::fill_n(m_sparse[page].get(), page_size, s_tombstone);
+        }
+
+        return m_sparse[page][to_index(id) % page_size];
+    }
+
+    /// Replaces the pages of the sparse array with copies of another
+    /// `::sparse_set`'s pages.
+    void copy_pages(const sparse_set& other)
+    {
+        m_sparse.clear();
+        m_sparse.resize(other.m_sparse.size());
+
+        for (std::size_t page { 0 }; page < m_sparse.size(); ++page) {
+            if (other.m_sparse[page] != nullptr) {
+                m_sparse[page]
+                    = std::make_unique_for_overwrite<id_type[]>(page_size);
+                std::copy_n(other.m_sparse[page].get(), page_size,
+                    m_sparse[page].get());
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<id_type[]>> m_sparse;
     std::vector<id_type> m_dense_ids;
     std::vector<value_type> m_dense_values;
+    std::vector<change_ticks> m_dense_ticks;
+    u32 m_tick { 0 };
+    std::vector<hook> m_on_insert;
+    std::vector<hook> m_on_update;
+    std::vector<hook> m_on_erase;
 };
 
 } // namespace eecs
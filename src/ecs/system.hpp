@@ -1,11 +1,15 @@
 #ifndef EECS_SYSTEM_HPP
 #define EECS_SYSTEM_HPP
 
+#include <functional>
+
 #include "world.hpp"
 
 namespace eecs {
 
-using system = void (*)(world&);
+/// A function run on a `::world` by a `::schedule`. It may be any copyable
+/// callable, which keeps its state between runs.
+using system = std::function<void(world&)>;
 
 } // namespace eecs
 
@@ -0,0 +1,283 @@
+#ifndef EECS_SYSTEM_PARAM_HPP
+#define EECS_SYSTEM_PARAM_HPP
+
+#include <cassert>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "access.hpp"
+#include "any.hpp"
+#include "command_buffer.hpp"
+#include "cow_ptr.hpp"
+#include "sparse_set.hpp"
+#include "types.hpp"
+#include "view.hpp"
+#include "world.hpp"
+
+namespace eecs {
+
+/// A system parameter giving access to a resource of type `T`, which must
+/// exist when the system first runs. A `const`-qualified type only allows
+/// reading the resource.
+///
+/// \tparam T The type of resource, optionally `const`-qualified.
+template <typename T>
+class res {
+public:
+    explicit res(T& resource) noexcept
+        : m_resource(&resource)
+    {
+    }
+
+    [[nodiscard]] T& operator*() const noexcept { return *m_resource; }
+    [[nodiscard]] T* operator->() const noexcept { return m_resource; }
+
+private:
+    T* m_resource;
+};
+
+/// The ticks of a run of a system.
+struct system_ticks {
+    /// The tick of the previous run of the system, up to which it has seen
+    /// the changes, or 0 if it never ran.
+    u32 last_run;
+    /// The tick of the current run, which its writes are stamped with.
+    u32 this_run;
+};
+
+/// Describes how a parameter of a system is resolved from a `::world`.
+///
+/// Each specialization has a `state` resolved once per `::world` by `init()`,
+/// a `fetch()` that builds the parameter from it and the `::system_ticks` of
+/// the run on each run, and the
+/// `::access` declarations implied by the parameter. A `::world&` parameter
+/// gives unrestricted access, which makes the system exclusive.
+///
+/// \tparam Param The type of parameter.
+template <typename Param>
+struct system_param;
+
+template <>
+struct system_param<world&> {
+    struct state { };
+    using declarations = std::tuple<>;
+
+    static state init(world& /*world*/) noexcept { return {}; }
+
+    static world& fetch(state& /*state*/, world& world,
+        const system_ticks& /*ticks*/) noexcept
+    {
+        return world;
+    }
+};
+
+template <typename... Terms>
+struct system_param<view<Terms...>> {
+    /// Resolves the copy-on-write pointer to a component collection, constant
+    /// if the collection is only read.
+    struct resolver {
+        world* target;
+
+        template <typename T>
+        auto* operator()(std::type_identity<T> /*unused*/) const
+        {
+            using pointer = cow_ptr<sparse_set<std::remove_const_t<T>>>;
+            using resolved = std::conditional_t<std::is_const_v<T>,
+                const pointer, pointer>;
+            return static_cast<resolved*>(
+                &target->slot<std::remove_const_t<T>>());
+        }
+    };
+
+    /// Declares reading every component of a term, or writing its component.
+    template <typename Term,
+        typename Components = typename view_term<Term>::components>
+    struct term_access;
+
+    template <typename Term, typename... T>
+    struct term_access<Term, std::tuple<T...>> {
+        using type = std::tuple<std::conditional_t<view_term<Term>::writes,
+            writes<T>, reads<T>>...>;
+    };
+
+    using state = std::tuple<decltype(resolve_term<Terms>(resolver {}))...>;
+    using declarations = decltype(std::tuple_cat(
+        std::declval<typename term_access<Terms>::type>()...));
+
+    static state init(world& world)
+    {
+        return state { resolve_term<Terms>(resolver { &world })... };
+    }
+
+    // Collections are only written through for the terms declared as
+    // writing them, so that concurrent readers neither copy nor race.
+    // Change filters match the changes since the previous run.
+    static view<Terms...> fetch(
+        state& state, world& /*world*/, const system_ticks& ticks)
+    {
+        const auto open { [](auto*... pools) {
+            return std::tuple { &access_pool(*pools)... };
+        } };
+
+        return std::apply(
+            [&ticks, &open](auto&... terms) {
+                return view<Terms...> { ticks.this_run, ticks.last_run,
+                    std::apply(open, terms)... };
+            },
+            state);
+    }
+
+private:
+    template <typename T>
+    static T& access_pool(cow_ptr<T>& pool)
+    {
+        return pool.write();
+    }
+
+    template <typename T>
+    static const T& access_pool(const cow_ptr<T>& pool) noexcept
+    {
+        return pool.read();
+    }
+};
+
+template <typename T>
+struct system_param<res<T>> {
+    using resource = std::remove_const_t<T>;
+    using state = any*;
+    using declarations = std::tuple<std::conditional_t<std::is_const_v<T>,
+        reads_resource<resource>, writes_resource<resource>>>;
+
+    static state init(world& world)
+    {
+        static_cast<void>(world.resource<resource>());
+        return &world.m_resources[world::resource_family::id<resource>()];
+    }
+
+    // The resource is cast on each run, so that it may be replaced.
+    static res<T> fetch(state& state, world& /*world*/,
+        const system_ticks& /*ticks*/) noexcept
+    {
+        assert(state->has_value());
+        return res<T> { unchecked_any_cast<resource>(*state) };
+    }
+};
+
+template <>
+struct system_param<command_buffer&> {
+    using state = any*;
+    // Recording commands is thread-safe.
+    using declarations = std::tuple<reads_resource<command_buffer>>;
+
+    static state init(world& world)
+    {
+        return system_param<res<command_buffer>>::init(world);
+    }
+
+    static command_buffer& fetch(
+        state& state, world& world, const system_ticks& ticks) noexcept
+    {
+        return *system_param<res<command_buffer>>::fetch(state, world, ticks);
+    }
+};
+
+/// Deduces the parameters of a system from its signature.
+///
+/// \tparam Fn The type of system: a function, a pointer to one, or a class
+///     with a single, non-template call operator.
+template <typename Fn>
+struct system_traits : system_traits<decltype(&Fn::operator())> { };
+
+template <typename... Params>
+struct system_traits<void(Params...)> {
+    using params = std::tuple<Params...>;
+};
+
+template <typename... Params>
+struct system_traits<void (*)(Params...)> : system_traits<void(Params...)> {
+};
+
+template <typename C, typename... Params>
+struct system_traits<void (C::*)(Params...)> : system_traits<void(Params...)> {
+};
+
+template <typename C, typename... Params>
+struct system_traits<void (C::*)(Params...) const>
+    : system_traits<void(Params...)> { };
+
+/// A system that resolves its parameters from the `::world` it runs on.
+///
+/// The state of each parameter is resolved on the first run and reused as
+/// long as the system runs on the same `::world`, as told by `world::id()`,
+/// so that running it does not look anything up by type. Each run takes a
+/// tick of its own from the `::world`, and remembers it so that the next run
+/// sees the changes made since.
+///
+/// \tparam Fn The type of function to invoke with the parameters.
+/// \tparam Params The tuple of parameter types.
+template <typename Fn, typename Params = typename system_traits<Fn>::params>
+class param_system;
+
+template <typename Fn, typename... Params>
+class param_system<Fn, std::tuple<Params...>> {
+public:
+    explicit param_system(Fn fn)
+        : m_fn(std::move(fn))
+    {
+    }
+
+    /// Returns the `::access` implied by the parameters.
+    ///
+    /// \return The `::access` implied by the parameters.
+    [[nodiscard]] static access implied_access()
+    {
+        if constexpr ((std::is_same_v<Params, world&> || ...)) {
+            return access {};
+        } else {
+            return access_of(decltype(std::tuple_cat(
+                std::declval<
+                    typename system_param<Params>::declarations>()...)) {});
+        }
+    }
+
+    void operator()(world& world)
+    {
+        if (m_world != world.id()) {
+            m_states = states { system_param<Params>::init(world)... };
+            m_world = world.id();
+            m_last_run = 0;
+        }
+
+        const system_ticks ticks { .last_run = m_last_run,
+            .this_run = world.increment_tick() };
+        std::apply(
+            [this, &world, &ticks](auto&... states) {
+                m_fn(system_param<Params>::fetch(states, world, ticks)...);
+            },
+            m_states);
+        m_last_run = ticks.this_run;
+    }
+
+private:
+    using states = std::tuple<typename system_param<Params>::state...>;
+
+    template <typename... Declarations>
+    static access access_of(std::tuple<Declarations...> /*unused*/)
+    {
+        return access::of<Declarations...>();
+    }
+
+    Fn m_fn;
+    // Keyed on the identifier rather than the address of the `::world`,
+    // which a later one may reuse.
+    std::optional<u64> m_world;
+    states m_states {};
+    u32 m_last_run { 0 };
+};
+
+} // namespace eecs
+
+#endif // !EECS_SYSTEM_PARAM_HPP
@@ -0,0 +1,146 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace eecs {
+
+namespace {
+
+    /// The pool that the calling thread works for, if any.
+    thread_local const thread_pool* t_pool { nullptr };
+
+    /// The index of the worker that the calling thread is, if any.
+    thread_local std::size_t t_index { 0 };
+
+} // namespace
+
+thread_pool::thread_pool(const std::size_t thread_count)
+{
+    const std::size_t queue_count { std::max<std::size_t>(thread_count, 1) };
+
+    m_queues.reserve(queue_count);
+    for (std::size_t i { 0 }; i < queue_count; ++i) {
+        m_queues.push_back(std::make_unique<queue>());
+    }
+
+    m_threads.reserve(thread_count);
+    for (std::size_t i { 0 }; i < thread_count; ++i) {
+        m_threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    wait_until([this] { return m_pending == 0; });
+
+    {
+        const std::lock_guard lock { m_mutex };
+        m_stop = true;
+    }
+    m_condition.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void thread_pool::submit(task task)
+{
+    const std::size_t index { t_pool == this
+            ? t_index
+            : m_next_queue.fetch_add(1, std::memory_order_relaxed)
+                % m_queues.size() };
+
+    // Counting the task before it is queued keeps `m_pending` an upper bound
+    // of the queued tasks, so it never underflows when the task is taken.
+    {
+        const std::lock_guard lock { m_mutex };
+        ++m_pending;
+    }
+
+    {
+        queue& queue { *m_queues[index] };
+        const std::lock_guard lock { queue.mutex };
+        queue.tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+    m_finished.notify_all();
+}
+
+bool thread_pool::try_run_one()
+{
+    const std::size_t index { t_pool == this ? t_index : 0 };
+
+    std::optional<task> task { take(index) };
+    if (!task) {
+        return false;
+    }
+
+    (*task)();
+    notify_finished();
+    return true;
+}
+
+void thread_pool::work(const std::size_t index)
+{
+    t_pool = this;
+    t_index = index;
+
+    while (true) {
+        if (std::optional<task> task { take(index) }) {
+            (*task)();
+            notify_finished();
+            continue;
+        }
+
+        std::unique_lock lock { m_mutex };
+        m_condition.wait(lock, [this] { return m_stop || m_pending > 0; });
+        if (m_stop && m_pending == 0) {
+            return;
+        }
+    }
+}
+
+std::optional<thread_pool::task> thread_pool::take(const std::size_t index)
+{
+    {
+        queue& own { *m_queues[index] };
+        const std::lock_guard lock { own.mutex };
+        if (!own.tasks.empty()) {
+            task task { std::move(own.tasks.back()) };
+            own.tasks.pop_back();
+            --m_pending;
+            return task;
+        }
+    }
+
+    for (std::size_t offset { 1 }; offset < m_queues.size(); ++offset) {
+        queue& victim { *m_queues[(index + offset) % m_queues.size()] };
+        const std::lock_guard lock { victim.mutex };
+        if (!victim.tasks.empty()) {
+            task task { std::move(victim.tasks.front()) };
+            victim.tasks.pop_front();
+            --m_pending;
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void thread_pool::notify_finished()
+{
+    // Taking the lock orders the effects of the task before the check of a
+    // waiter that is about to block.
+    {
+        const std::lock_guard lock { m_mutex };
+    }
+    m_finished.notify_all();
+}
+
+} // namespace eecs
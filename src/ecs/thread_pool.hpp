@@ -0,0 +1,167 @@
+#ifndef EECS_THREAD_POOL_HPP
+#define EECS_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace eecs {
+
+/// A work-stealing pool of worker threads.
+///
+/// Each worker owns a queue of tasks. Workers take the newest task from their
+/// own queue and, when it runs dry, steal the oldest task from another
+/// worker's queue. Threads that wait on the pool help run tasks, and only
+/// block once there are none left, so tasks may themselves submit and wait
+/// on other tasks.
+class thread_pool {
+public:
+    /// A unit of work.
+    using task = std::function<void()>;
+
+    /// Constructs a `::thread_pool` with the given number of workers.
+    ///
+    /// \param thread_count The number of worker threads. With no workers,
+    ///     tasks are run by the threads that wait on the pool.
+    explicit thread_pool(
+        std::size_t thread_count = std::thread::hardware_concurrency());
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool(thread_pool&& other) noexcept = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+    thread_pool& operator=(thread_pool&& other) noexcept = delete;
+
+    /// Stops the workers once they have run every pending task.
+    ~thread_pool();
+
+    /// Returns the number of worker threads.
+    ///
+    /// \return The number of worker threads.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    /// Submits a task to run on the pool. Tasks submitted from a worker go to
+    /// that worker's own queue.
+    ///
+    /// \param task The task to run.
+    void submit(task task);
+
+    /// Runs one pending task on the calling thread, if there is one.
+    ///
+    /// \return `true` if a task was run; `false` otherwise.
+    bool try_run_one();
+
+    /// Runs pending tasks on the calling thread until a condition holds,
+    /// blocking while there are none to run.
+    ///
+    /// \tparam Predicate The type of the condition.
+    /// \param done The condition to wait for, which must only become true as
+    ///     tasks of this pool run.
+    template <typename Predicate>
+    void wait_until(Predicate done)
+    {
+        while (!done()) {
+            if (try_run_one()) {
+                continue;
+            }
+
+            std::unique_lock lock { m_mutex };
+            m_finished.wait(
+                lock, [this, &done] { return m_pending > 0 || done(); });
+        }
+    }
+
+    /// Splits the range `[0, count)` into chunks of `grain` indices and
+    /// invokes a function on each chunk across the pool, waiting for all of
+    /// them to finish. The calling thread processes the first chunk itself.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param count The number of indices.
+    /// \param grain The maximum number of indices per chunk.
+    /// \param fn The function to invoke with the first and one past the last
+    ///     index of each chunk.
+    /// \throws Any exception thrown by `fn`.
+    template <typename Fn>
+    void parallel_for(const std::size_t count, std::size_t grain, Fn&& fn)
+    {
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunk_count { (count + grain - 1) / grain };
+
+        if (chunk_count <= 1) {
+            if (count > 0) {
+                fn(std::size_t { 0 }, count);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> remaining { chunk_count };
+        std::mutex mutex;
+        std::exception_ptr exception;
+
+        const auto run_chunk = [&](const std::size_t chunk) {
+            try {
+                fn(chunk * grain, std::min(count, (chunk + 1) * grain));
+            } catch (...) {
+                const std::lock_guard lock { mutex };
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        };
+
+        for (std::size_t chunk { 1 }; chunk < chunk_count; ++chunk) {
+            submit([&run_chunk, chunk] { run_chunk(chunk); });
+        }
+        run_chunk(0);
+
+        wait_until([&remaining] {
+            return remaining.load(std::memory_order_acquire) == 0;
+        });
+
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+private:
+    /// A queue of tasks owned by a worker.
+    struct queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    /// Runs tasks on worker `index` until the pool is stopped.
+    void work(std::size_t index);
+
+    /// Takes a task, preferring the newest one of queue `index` and
+    /// otherwise stealing the oldest one of another queue.
+    std::optional<task> take(std::size_t index);
+
+    /// Wakes the threads waiting on the pool after a task has run, so that
+    /// they check their condition again.
+    void notify_finished();
+
+    std::vector<std::unique_ptr<queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next_queue { 0 };
+    std::atomic<std::size_t> m_pending { 0 };
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_finished;
+    bool m_stop { false };
+};
+
+} // namespace eecs
+
+#endif // !EECS_THREAD_POOL_HPP
@@ -0,0 +1,51 @@
+#ifndef EECS_TIME_HPP
+#define EECS_TIME_HPP
+
+#include <chrono>
+
+#include "types.hpp"
+
+namespace eecs {
+
+/// A resource describing the passage of time in an `::app`, updated at the
+/// start of every frame.
+struct time {
+    using duration = std::chrono::nanoseconds;
+
+    /// The time since the start of the previous frame.
+    duration delta {};
+
+    /// The time since the first frame started.
+    duration elapsed {};
+
+    /// The time simulated by each run of `event::fixed_update`.
+    duration fixed_delta {};
+
+    /// The fraction of a fixed step that has passed but is not simulated
+    /// yet, in `[0, 1)`, e.g., to interpolate between fixed updates.
+    double overstep { 0.0 };
+
+    /// The number of frames started so far, including the current one.
+    u64 frame { 0 };
+
+    /// Returns the time since the start of the previous frame, in seconds.
+    ///
+    /// \return The time since the start of the previous frame.
+    [[nodiscard]] float delta_seconds() const noexcept
+    {
+        return std::chrono::duration<float> { delta }.count();
+    }
+
+    /// Returns the time simulated by each run of `event::fixed_update`, in
+    /// seconds.
+    ///
+    /// \return The fixed time step.
+    [[nodiscard]] float fixed_delta_seconds() const noexcept
+    {
+        return std::chrono::duration<float> { fixed_delta }.count();
+    }
+};
+
+} // namespace eecs
+
+#endif // !EECS_TIME_HPP
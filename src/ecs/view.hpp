@@ -0,0 +1,507 @@
+#ifndef EECS_VIEW_HPP
+#define EECS_VIEW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "entity.hpp"
+#include "sparse_set.hpp"
+#include "thread_pool.hpp"
+#include "types.hpp"
+
+namespace eecs {
+
+/// A `::view` term that matches entities whose component of type `T` was
+/// inserted since the view's reference tick. The component is not passed to
+/// the invoked function.
+template <typename T>
+struct added { };
+
+/// A `::view` term that matches entities whose component of type `T` was
+/// inserted or modified since the view's reference tick. The component is
+/// not passed to the invoked function.
+template <typename T>
+struct changed { };
+
+/// A `::view` term that matches entities associated with none of the
+/// components of types `T`. Nothing is passed to the invoked function.
+template <typename... T>
+struct exclude { };
+
+/// A `::view` term that matches every entity and passes a pointer to its
+/// component of type `T`, or `nullptr` if it has none. A `const`-qualified
+/// type yields a pointer to a constant component.
+template <typename T>
+struct maybe { };
+
+/// How a term of a `::view` takes part in matching.
+enum class term_kind {
+    /// The component must be present, and may drive the iteration.
+    required,
+    /// The component may be absent.
+    optional,
+    /// The components must all be absent.
+    excluded,
+};
+
+/// Describes how a term of a `::view` is matched and what it yields.
+///
+/// A plain type of component yields a reference to the component and marks
+/// it as changed; a `const`-qualified one yields a constant reference and
+/// leaves it untouched.
+///
+/// \tparam Term The term to describe.
+template <typename Term>
+struct view_term {
+    using component = std::remove_const_t<Term>;
+    using components = std::tuple<component>;
+    using yield = std::tuple<Term&>;
+
+    static constexpr term_kind kind { term_kind::required };
+    static constexpr bool writes { !std::is_const_v<Term> };
+
+    static constexpr bool matches(
+        const change_ticks& /*ticks*/, const u32 /*since*/) noexcept
+    {
+        return true;
+    }
+};
+
+template <typename T>
+struct view_term<added<T>> {
+    using component = T;
+    using components = std::tuple<component>;
+    using yield = std::tuple<>;
+
+    static constexpr term_kind kind { term_kind::required };
+    static constexpr bool writes { false };
+
+    static constexpr bool matches(
+        const change_ticks& ticks, const u32 since) noexcept
+    {
+        return ticks.added > since;
+    }
+};
+
+template <typename T>
+struct view_term<changed<T>> {
+    using component = T;
+    using components = std::tuple<component>;
+    using yield = std::tuple<>;
+
+    static constexpr term_kind kind { term_kind::required };
+    static constexpr bool writes { false };
+
+    static constexpr bool matches(
+        const change_ticks& ticks, const u32 since) noexcept
+    {
+        return ticks.changed > since;
+    }
+};
+
+template <typename T>
+struct view_term<maybe<T>> {
+    using component = std::remove_const_t<T>;
+    using components = std::tuple<component>;
+    using yield = std::tuple<T*>;
+
+    static constexpr term_kind kind { term_kind::optional };
+    static constexpr bool writes { !std::is_const_v<T> };
+};
+
+template <typename... T>
+struct view_term<exclude<T...>> {
+    static_assert(sizeof...(T) > 0, "An exclusion needs a component");
+
+    using components = std::tuple<T...>;
+    using yield = std::tuple<>;
+
+    static constexpr term_kind kind { term_kind::excluded };
+    static constexpr bool writes { false };
+};
+
+/// A type of component needed by a term of a `::view`, `const`-qualified
+/// unless the term writes to it.
+template <typename Term, typename T>
+using term_component
+    = std::conditional_t<view_term<Term>::writes, T, const T>;
+
+/// Resolves the collection of each type of component that a term of a
+/// `::view` needs.
+///
+/// Only the collections of terms that write are resolved for writing, so that
+/// reading a collection shared by `world::freeze()` neither copies it nor
+/// races with other readers.
+///
+/// \tparam Term The term to resolve the collections of.
+/// \tparam Resolve The type of function to resolve a collection with.
+/// \param resolve The function to invoke with a `std::type_identity` of each
+///     type of component, `const`-qualified if it is only read, returning its
+///     collection.
+/// \return The tuple of resolved collections.
+template <typename Term, typename Resolve>
+auto resolve_term(Resolve&& resolve)
+{
+    return [&resolve]<typename... T>(
+               std::type_identity<std::tuple<T...>> /*unused*/) {
+        return std::tuple { resolve(
+            std::type_identity<term_component<Term, T>> {})... };
+    }(std::type_identity<typename view_term<Term>::components> {});
+}
+
+/// A non-owning view over every `::entity` associated with all of the given
+/// types of components.
+///
+/// The component collections are resolved once, when the view is constructed.
+/// Iteration is driven by the smallest collection of a required term, so the
+/// number of candidates visited is bounded by the rarest required component
+/// rather than the first one listed. `::exclude` and `::maybe` terms are only
+/// looked up for candidates that have every required component.
+///
+/// Components yielded through a non-`const` term are stamped as changed at
+/// the view's tick, whether or not they are actually modified, so read-only
+/// access should be declared with `const`. Change filters match components
+/// stamped after the view's reference tick, see `since()`.
+///
+/// \tparam Terms The types of components that each `::entity` must be
+///     associated with, optionally `const`-qualified, `::added` or
+///     `::changed` filters, and `::exclude` or `::maybe` terms.
+template <typename... Terms>
+class view {
+    static_assert(((view_term<Terms>::kind == term_kind::required) || ...),
+        "A view needs at least one required component");
+
+    template <typename Term,
+        typename Components = typename view_term<Term>::components>
+    struct pools_of;
+
+    template <typename Term, typename... T>
+    struct pools_of<Term, std::tuple<T...>> {
+        using type = std::tuple<std::conditional_t<view_term<Term>::writes,
+            sparse_set<T>, const sparse_set<T>>*...>;
+    };
+
+    /// The component collections of a term, constant unless it writes.
+    template <typename Term>
+    using term_pools = typename pools_of<Term>::type;
+
+    /// A pointer to the component of a term, unused by `::exclude` terms.
+    template <typename Term>
+    using pointer = term_component<Term,
+        std::tuple_element_t<0, typename view_term<Term>::components>>*;
+
+    using pointers = std::tuple<pointer<Terms>...>;
+
+public:
+    /// The tuple of the `::entity` and the components yielded for it.
+    using value_type = decltype(std::tuple_cat(
+        std::declval<std::tuple<entity>>(),
+        std::declval<typename view_term<Terms>::yield>()...));
+
+    /// An iterator over the matching entities of a `::view`. Dereferencing
+    /// yields a tuple of the `::entity` and references to its components.
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = view::value_type;
+        using reference = value_type;
+
+        iterator() noexcept = default;
+
+        reference operator*() const noexcept
+        {
+            return m_view->yield(m_ids[m_pos], m_current);
+        }
+
+        iterator& operator++() noexcept
+        {
+            ++m_pos;
+            seek();
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator copy { *this };
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const iterator& other) const noexcept
+        {
+            return m_pos == other.m_pos;
+        }
+
+    private:
+        friend class view;
+
+        iterator(const view* view, std::span<const entity> ids,
+            const std::size_t pos) noexcept
+            : m_view(view)
+            , m_ids(ids)
+            , m_pos(pos)
+        {
+            seek();
+        }
+
+        /// Advances to the next matching `::entity`, starting at the current
+        /// position.
+        void seek() noexcept
+        {
+            while (m_pos < m_ids.size()
+                && !m_view->fetch(m_ids[m_pos], m_current)) {
+                ++m_pos;
+            }
+        }
+
+        const view* m_view { nullptr };
+        std::span<const entity> m_ids;
+        std::size_t m_pos { 0 };
+        pointers m_current {};
+    };
+
+    /// Constructs a `::view` over the given component collections.
+    ///
+    /// \param tick The tick to stamp components yielded for writing with.
+    /// \param since The reference tick of change filters.
+    /// \param pools The component collections of each term, see
+    ///     `resolve_term()`.
+    explicit view(const u32 tick, const u32 since,
+        term_pools<Terms>... pools) noexcept
+        : m_pools(pools...)
+        , m_tick(tick)
+        , m_since(since)
+    {
+        choose_driver(indices {});
+    }
+
+    /// Returns a copy of this `::view` whose change filters match components
+    /// stamped after the given tick instead.
+    ///
+    /// \param tick The new reference tick. Passing the tick before the one
+    ///     the caller last iterated at reports every change made since.
+    /// \return The new `::view`.
+    [[nodiscard]] view since(const u32 tick) const noexcept
+    {
+        view copy { *this };
+        copy.m_since = tick;
+        return copy;
+    }
+
+    /// Returns an iterator to the first matching `::entity`.
+    ///
+    /// \return An iterator to the first matching `::entity`.
+    [[nodiscard]] iterator begin() const noexcept
+    {
+        return iterator { this, m_driver, 0 };
+    }
+
+    /// Returns an iterator past the last matching `::entity`.
+    ///
+    /// \return An iterator past the last matching `::entity`.
+    [[nodiscard]] iterator end() const noexcept
+    {
+        return iterator { this, m_driver, m_driver.size() };
+    }
+
+    /// Returns an upper bound on the number of matching entities, i.e., the
+    /// size of the smallest component collection of a required term.
+    ///
+    /// \return The number of candidate entities.
+    [[nodiscard]] std::size_t size_hint() const noexcept
+    {
+        return m_driver.size();
+    }
+
+    /// Checks whether an `::entity` is associated with all of the required
+    /// types of components, none of the excluded ones, and passes every
+    /// change filter.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` matches; `false` otherwise.
+    [[nodiscard]] bool contains(const entity entity) const noexcept
+    {
+        pointers components;
+        return fetch(entity, components);
+    }
+
+    /// Invokes a function on each matching `::entity` and its components.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param fn The function to invoke with the `::entity` followed by a
+    ///     reference to each of its viewed components.
+    template <typename Fn>
+    void each(Fn&& fn) const
+    {
+        each_in(0, m_driver.size(), fn);
+    }
+
+    /// Invokes a function on each matching `::entity` and its components,
+    /// splitting the entities across a `::thread_pool` in chunks.
+    ///
+    /// The function may be invoked concurrently for different entities, so it
+    /// must only touch the components it is given, or synchronize otherwise.
+    /// The viewed collections must not be modified until this returns.
+    ///
+    /// \tparam Fn The type of function to invoke.
+    /// \param pool The `::thread_pool` to run on.
+    /// \param fn The function to invoke with the `::entity` followed by a
+    ///     reference to each of its viewed components.
+    /// \param grain The maximum number of candidate entities per chunk.
+    template <typename Fn>
+    void par_each(thread_pool& pool, Fn&& fn,
+        const std::size_t grain = default_grain) const
+    {
+        pool.parallel_for(m_driver.size(), grain,
+            [this, &fn](const std::size_t first, const std::size_t last) {
+                each_in(first, last, fn);
+            });
+    }
+
+    /// The default number of candidate entities per chunk of `par_each()`.
+    static constexpr std::size_t default_grain { 1024 };
+
+private:
+    using indices = std::index_sequence_for<Terms...>;
+
+    template <std::size_t I>
+    using term_at = view_term<std::tuple_element_t<I, std::tuple<Terms...>>>;
+
+    /// Drives the iteration by the smallest collection of a required term.
+    template <std::size_t... I>
+    void choose_driver(std::index_sequence<I...> /*unused*/) noexcept
+    {
+        bool chosen { false };
+        const auto consider { [this, &chosen](const auto* pool) {
+            if (!chosen || pool->size() < m_driver.size()) {
+                m_driver = pool->ids();
+                chosen = true;
+            }
+        } };
+
+        ((term_at<I>::kind == term_kind::required
+                 ? consider(std::get<0>(std::get<I>(m_pools)))
+                 : void()),
+            ...);
+    }
+
+    /// Invokes a function on each matching `::entity` among the candidates at
+    /// positions `[first, last)` of the driving collection.
+    template <typename Fn>
+    void each_in(const std::size_t first, const std::size_t last, Fn& fn) const
+    {
+        pointers components;
+        for (std::size_t i { first }; i < last; ++i) {
+            const entity entity { m_driver[i] };
+            if (fetch(entity, components)) {
+                std::apply(fn, yield(entity, components));
+            }
+        }
+    }
+
+    /// Looks up the components of an `::entity` in every collection and
+    /// checks them against the change filters and exclusions. Optional
+    /// components are only looked up once every other term matched.
+    ///
+    /// \param entity The `::entity` to look up.
+    /// \param components The pointers to fill with the found components.
+    /// \return `true` if every term matched; `false` otherwise.
+    bool fetch(const entity entity, pointers& components) const noexcept
+    {
+        return fetch(entity, components, indices {});
+    }
+
+    template <std::size_t... I>
+    bool fetch(const entity entity, pointers& components,
+        std::index_sequence<I...> /*unused*/) const noexcept
+    {
+        if (!(fetch_term<I>(entity, std::get<I>(components)) && ...)) {
+            return false;
+        }
+
+        (fetch_optional<I>(entity, std::get<I>(components)), ...);
+        return true;
+    }
+
+    template <std::size_t I, typename T>
+    bool fetch_term(const entity entity, T*& component) const noexcept
+    {
+        using term = term_at<I>;
+        const auto& pools { std::get<I>(m_pools) };
+
+        if constexpr (term::kind == term_kind::required) {
+            auto* pool { std::get<0>(pools) };
+            component = pool->find(entity);
+            return component != nullptr
+                && term::matches(
+                    pool->ticks()[component - pool->data()], m_since);
+        } else if constexpr (term::kind == term_kind::excluded) {
+            return std::apply(
+                [entity](const auto*... pools) {
+                    return !(pools->contains(entity) || ...);
+                },
+                pools);
+        } else {
+            return true;
+        }
+    }
+
+    template <std::size_t I, typename T>
+    void fetch_optional(const entity entity, T*& component) const noexcept
+    {
+        if constexpr (term_at<I>::kind == term_kind::optional) {
+            component = std::get<0>(std::get<I>(m_pools))->find(entity);
+        }
+    }
+
+    /// Builds the tuple of an `::entity` and its yielded components, stamping
+    /// those yielded for writing as changed.
+    value_type yield(
+        const entity entity, const pointers& components) const noexcept
+    {
+        return yield(entity, components, indices {});
+    }
+
+    template <std::size_t... I>
+    value_type yield(const entity entity, const pointers& components,
+        std::index_sequence<I...> /*unused*/) const noexcept
+    {
+        return std::tuple_cat(std::tuple<eecs::entity> { entity },
+            yield_term<I>(std::get<I>(components))...);
+    }
+
+    template <std::size_t I, typename T>
+    auto yield_term(T* component) const noexcept
+    {
+        using term = term_at<I>;
+
+        if constexpr (term::writes) {
+            auto* pool { std::get<0>(std::get<I>(m_pools)) };
+            if (term::kind != term_kind::optional || component != nullptr) {
+                pool->ticks()[component - pool->data()].changed = m_tick;
+            }
+        }
+
+        if constexpr (std::tuple_size_v<typename term::yield> == 0) {
+            return std::tuple<> {};
+        } else if constexpr (term::kind == term_kind::optional) {
+            return typename term::yield { component };
+        } else {
+            return typename term::yield { *component };
+        }
+    }
+
+    std::tuple<term_pools<Terms>...> m_pools;
+    std::span<const entity> m_driver;
+    u32 m_tick;
+    u32 m_since;
+};
+
+} // namespace eecs
+
+#endif // !EECS_VIEW_HPP
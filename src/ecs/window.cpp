@@ -31,6 +31,10 @@ window::window(const std::string& title, const int width, const int height)
 {
 }
 
+window::window(window&& other) noexcept = default;
+
+window& window::operator=(window&& other) noexcept = default;
+
 window::~window() = default;
 
 } // namespace eecs
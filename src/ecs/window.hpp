@@ -11,9 +11,9 @@ class window {
 public:
     window(const std::string& title, int width, int height);
     window(const window& other) = delete;
-    window(window&& other) noexcept = default;
+    window(window&& other) noexcept;
     window& operator=(const window& other) = delete;
-    window& operator=(window&& other) noexcept = default;
+    window& operator=(window&& other) noexcept;
     ~window();
 
     auto operator<=>(const window&) const = default;
@@ -1,26 +1,146 @@
 #ifndef EECS_WORLD_HPP
 #define EECS_WORLD_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <tuple>
-#include <typeindex>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "any.hpp"
+#include "cow_ptr.hpp"
 #include "entity.hpp"
+#include "events.hpp"
+#include "family.hpp"
+#include "group.hpp"
+#include "query.hpp"
 #include "sparse_set.hpp"
+#include "types.hpp"
+#include "view.hpp"
 
 namespace eecs {
 
+class access;
+class frozen_world;
+
 /// A specialized container for storing, querying, and interacting with
 /// entities, components, and resources.
+///
+/// Every inserted or modified component is stamped with the `::world`'s
+/// current tick. `advance_tick()` moves it forward to start a new frame, and
+/// each run of a system takes a tick of its own from `increment_tick()`.
+/// Views can then filter for components that were `::added` or `::changed`
+/// since a given tick, by default since the start of the current frame.
+///
+/// Component collections are copied on write, so that `freeze()` can hand
+/// out the current state to background readers without copying it.
 class world {
 public:
-    /// Creates a new `::entity`.
+    /// Creates a new `::entity`, recycling the index of a destroyed one if
+    /// possible.
     ///
     /// \return A new `::entity` identifier.
-    entity create() noexcept { return m_next_entity++; }
+    /// \throws std::length_error if every index is in use.
+    entity create()
+    {
+        if (m_free_index == traits::index_mask) {
+            const auto index { static_cast<entity>(m_entities.size()) };
+            if (index == traits::index_mask) {
+                throw std::length_error("Too many entities");
+            }
+
+            ++m_size;
+            return m_entities.emplace_back(traits::construct(index, 0));
+        }
+
+        ++m_size;
+        const entity index { m_free_index };
+        entity& slot { m_entities[index] };
+        m_free_index = traits::to_index(slot);
+        slot = traits::construct(index, traits::to_version(slot));
+        return slot;
+    }
+
+    /// Creates `count` new entities, recycling the indices of destroyed ones
+    /// first.
+    ///
+    /// \param count The number of entities to create.
+    /// \return The new `::entity` identifiers.
+    /// \throws std::length_error if there are not enough free indices.
+    std::vector<entity> create(const std::size_t count)
+    {
+        std::vector<entity> entities;
+        entities.reserve(count);
+
+        while (entities.size() < count && m_free_index != traits::index_mask) {
+            entities.push_back(create());
+        }
+
+        const std::size_t fresh { count - entities.size() };
+        if (fresh > traits::index_mask - m_entities.size()) {
+            for (const entity entity : entities) {
+                destroy(entity);
+            }
+            throw std::length_error("Too many entities");
+        }
+
+        m_entities.reserve(m_entities.size() + fresh);
+        m_size += fresh;
+        for (std::size_t i { 0 }; i < fresh; ++i) {
+            const auto index { static_cast<entity>(m_entities.size()) };
+            entities.push_back(
+                m_entities.emplace_back(traits::construct(index, 0)));
+        }
+
+        return entities;
+    }
+
+    /// Destroys an `::entity`, removing all of its components. Its index is
+    /// recycled by a later `create()`, with a bumped version so that the
+    /// destroyed identifier is no longer `valid()`.
+    ///
+    /// \param entity The `::entity` to destroy. Must be `valid()`.
+    void destroy(const entity entity)
+    {
+        assert(valid(entity));
+
+        // Hooks may register new types of components, which grows the pools
+        // and invalidates iterators, so they are walked by index.
+        for (std::size_t id { 0 }; id < m_pools.size(); ++id) {
+            if (m_pools[id].erase != nullptr) {
+                m_pools[id].erase(*this, entity);
+            }
+        }
+
+        const auto index { traits::to_index(entity) };
+        m_entities[index] = traits::construct(
+            m_free_index, traits::to_version(entity) + 1);
+        m_free_index = index;
+        --m_size;
+    }
+
+    /// Returns the number of alive entities.
+    ///
+    /// \return The number of alive entities.
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+    /// Checks whether an `::entity` was created by this `::world` and has not
+    /// been destroyed since.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` is alive; `false` otherwise.
+    [[nodiscard]] bool valid(const entity entity) const noexcept
+    {
+        const auto index { traits::to_index(entity) };
+        return index < m_entities.size() && m_entities[index] == entity;
+    }
 
     /// Inserts a component into this `::world` and associates it with an
     /// `::entity`.
@@ -32,7 +152,33 @@ public:
     void insert(entity entity, const T& component)
     {
         sparse_set<T>& components { this->components<T>() };
+        components.set_tick(tick());
         components.insert(entity, component);
+        on_insert<T>(entity);
+    }
+
+    /// Inserts a component into this `::world` for each of the given
+    /// entities, resolving the component collection and allocating room for
+    /// the components once.
+    ///
+    /// \tparam T The type of component to insert.
+    /// \param entities The entities to associate the components with.
+    /// \param components The components to insert, one per `::entity`.
+    template <typename T>
+    void insert(
+        const std::span<const entity> entities, std::span<const T> components)
+    {
+        assert(entities.size() == components.size());
+
+        sparse_set<T>& pool { this->components<T>() };
+        pool.set_tick(tick());
+        pool.insert(entities.begin(), entities.end(), components.begin());
+
+        if (owner<T>() != nullptr) {
+            for (const entity entity : entities) {
+                on_insert<T>(entity);
+            }
+        }
     }
 
     /// Inserts a new component into this `::world` constructed in-place with
@@ -47,7 +193,96 @@ public:
     void emplace(const entity entity, Args&&... args)
     {
         sparse_set<T>& components { this->components<T>() };
+        components.set_tick(tick());
         components.emplace(entity, std::forward<Args>(args)...);
+        on_insert<T>(entity);
+    }
+
+    /// Removes a component (if one exists) from an `::entity`. The
+    /// `::entity` is then reported by `removed()` until the second
+    /// `advance_tick()` after.
+    ///
+    /// \tparam T The type of component to remove.
+    /// \param entity The `::entity` to remove the component from.
+    template <typename T>
+    void erase(const entity entity)
+    {
+        if (!slot<T>().read().contains(entity)) {
+            return;
+        }
+
+        pool& pool { m_pools[component_family::id<T>()] };
+        pool.removed.push_back(entity);
+        pool.removed_ticks.push_back(tick());
+        on_erase<T>(entity);
+        components<T>().erase(entity);
+    }
+
+    /// Removes the components (if they exist) of the given type from each of
+    /// the given entities.
+    ///
+    /// \tparam T The type of component to remove.
+    /// \param entities The entities to remove the components from.
+    template <typename T>
+    void erase(const std::span<const entity> entities)
+    {
+        for (const entity entity : entities) {
+            erase<T>(entity);
+        }
+    }
+
+    /// Connects a hook notified after a component of type `T` is inserted
+    /// for an `::entity` that had none.
+    ///
+    /// Hooks run on the thread that modifies the components, while the
+    /// modification is in progress, so they must not insert or erase
+    /// components of the same type. A type of component without hooks only
+    /// pays for checking that there are none.
+    ///
+    /// \tparam T The type of component to observe.
+    /// \param hook The function to notify with the `::entity`, along with its
+    ///     context.
+    template <typename T>
+    void on_construct(const sparse_set_hook<entity> hook)
+    {
+        components<T>().on_insert(hook);
+    }
+
+    /// Connects a hook notified after a component of type `T` is replaced by
+    /// `insert()` or `emplace()`. Writes through references, e.g., from a
+    /// `::view`, do not notify it.
+    ///
+    /// \tparam T The type of component to observe.
+    /// \param hook The function to notify with the `::entity`, along with its
+    ///     context.
+    template <typename T>
+    void on_update(const sparse_set_hook<entity> hook)
+    {
+        components<T>().on_update(hook);
+    }
+
+    /// Connects a hook notified before a component of type `T` is erased,
+    /// including when its `::entity` is destroyed or this `::world` is
+    /// cleared. The component can still be read from the hook.
+    ///
+    /// \tparam T The type of component to observe.
+    /// \param hook The function to notify with the `::entity`, along with its
+    ///     context. Must not throw.
+    template <typename T>
+    void on_destroy(const sparse_set_hook<entity> hook)
+    {
+        components<T>().on_erase(hook);
+    }
+
+    /// Disconnects every hook on components of type `T` connected with the
+    /// given context.
+    ///
+    /// \tparam T The type of component to stop observing.
+    /// \param context The context the hooks were connected with.
+    template <typename T>
+    void disconnect(const void* context)
+    {
+        components<T>().disconnect(context);
     }
 
     /// Inserts a new resource into this `::world` constructed in-place with
@@ -65,40 +300,246 @@ public:
     template <typename T, typename... Args>
     void emplace(Args&&... args)
     {
-        const auto type_id { std::type_index(typeid(T)) };
-        m_resources.emplace(std::piecewise_construct,
-            std::forward_as_tuple(type_id),
-            std::forward_as_tuple(
-                std::in_place_type_t<T> {}, std::forward<Args>(args)...));
+        const u32 id { resource_family::id<T>() };
+
+        if (id >= m_resources.size()) {
+            m_resources.resize(id + 1);
+        }
+
+        m_resources[id]
+            = any { std::in_place_type_t<T> {}, std::forward<Args>(args)... };
     }
 
-    /// Clears all entities from this `::world`.
+    /// Returns the current tick, which inserted and modified components are
+    /// stamped with.
+    ///
+    /// \return The current tick.
+    [[nodiscard]] u32 tick() const noexcept
+    {
+        return m_tick->load(std::memory_order_relaxed);
+    }
+
+    /// Returns the current tick and moves on to the next one, without
+    /// starting a new frame. Each run of a system stamps its writes with a
+    /// tick taken this way, so that the writes made after it, even during
+    /// the same frame, have later ticks. May be called from several threads
+    /// at once.
+    ///
+    /// \return The tick taken.
+    u32 increment_tick() noexcept
+    {
+        return m_tick->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Returns the tick at which the current frame started, i.e., of the
+    /// last `advance_tick()`.
+    ///
+    /// \return The tick at which the current frame started.
+    [[nodiscard]] u32 frame_tick() const noexcept { return m_frame_tick; }
+
+    /// Returns the identifier of this `::world`, unique among the worlds
+    /// created by the program, unlike its address. It moves along with the
+    /// `::world`'s state.
+    ///
+    /// \return The identifier.
+    [[nodiscard]] u64 id() const noexcept { return m_id; }
+
+    /// Inserts a channel of events of the given type as a resource, if there
+    /// is none yet. Its buffers are then swapped by every `advance_tick()`.
+    ///
+    /// \tparam T The type of event.
+    /// \return A reference to the channel.
+    template <typename T>
+    events<T>& add_events()
+    {
+        if (auto* channel { try_resource<events<T>>() }) {
+            return *channel;
+        }
+
+        emplace<events<T>>();
+        m_event_updates.push_back([](world& world) noexcept {
+            if (auto* channel { world.try_resource<events<T>>() }) {
+                channel->update();
+            }
+        });
+        return resource<events<T>>();
+    }
+
+    /// Starts a new frame at the next tick, so that components stamped so
+    /// far no longer match the `::added` and `::changed` filters of new
+    /// views by default, forgets the components removed before the previous
+    /// frame and drops the events sent before the previous frame.
+    void advance_tick() noexcept
+    {
+        const u32 previous { m_frame_tick };
+        m_frame_tick = increment_tick() + 1;
+
+        // Removals are kept for a whole frame more, so that systems that ran
+        // before them during their frame still see them during the next.
+        for (std::size_t id { 0 }; id < m_pools.size(); ++id) {
+            pool& pool { m_pools[id] };
+            const auto kept { std::ranges::lower_bound(
+                pool.removed_ticks, previous) };
+            const auto dropped { kept - pool.removed_ticks.begin() };
+            pool.removed.erase(
+                pool.removed.begin(), pool.removed.begin() + dropped);
+            pool.removed_ticks.erase(pool.removed_ticks.begin(), kept);
+        }
+
+        for (const auto update : m_event_updates) {
+            update(*this);
+        }
+    }
+
+    /// Returns the entities whose components of the given type were removed,
+    /// or that were destroyed, since the last `advance_tick()`.
+    ///
+    /// \tparam T The type of removed component.
+    /// \return A view of the entities, in order of removal. Invalidated by
+    ///     removing more components of the same type.
+    template <typename T>
+    [[nodiscard]] std::span<const entity> removed()
+    {
+        return removed<T>(m_frame_tick - 1);
+    }
+
+    /// Returns the entities whose components of the given type were removed,
+    /// or that were destroyed, after the given tick. Removals are only kept
+    /// until the second `advance_tick()` after them.
+    ///
+    /// \tparam T The type of removed component.
+    /// \param since The last tick whose removals are not returned, e.g., of
+    ///     the last time the caller looked.
+    /// \return A view of the entities, in order of removal. Invalidated by
+    ///     removing more components of the same type.
+    template <typename T>
+    [[nodiscard]] std::span<const entity> removed(const u32 since)
+    {
+        static_cast<void>(slot<T>());
+        const pool& pool { m_pools[component_family::id<T>()] };
+        const auto first { std::ranges::upper_bound(
+            pool.removed_ticks, since) };
+        return std::span<const entity> { pool.removed }.subspan(
+            static_cast<std::size_t>(first - pool.removed_ticks.begin()));
+    }
+
+    /// Clears all entities from this `::world`. Their indices are recycled
+    /// by later calls to `create()`, with bumped versions so that the cleared
+    /// identifiers are no longer `valid()`.
+    ///
+    /// Invalidates every `::view` obtained from this `::world`. Component
+    /// collections, `::group`s, and `::query`s stay valid, and are emptied.
     void clear()
     {
-        m_next_entity = 0;
-        m_components.clear();
+        // Hooks may register new types of components, like in `destroy()`.
+        for (std::size_t id { 0 }; id < m_pools.size(); ++id) {
+            pool& pool { m_pools[id] };
+            if (pool.clear != nullptr) {
+                pool.clear(pool.components);
+            }
+            pool.removed.clear();
+            pool.removed_ticks.clear();
+        }
+
+        for (const auto& group : m_groups) {
+            if (group != nullptr) {
+                group->size = 0;
+            }
+        }
+
+        // Every slot is threaded onto the free list in order, and those of
+        // alive entities get a bumped version, like in `destroy()`.
+        for (std::size_t index { 0 }; index < m_entities.size(); ++index) {
+            entity& slot { m_entities[index] };
+            const auto next { index + 1 < m_entities.size()
+                    ? static_cast<entity>(index + 1)
+                    : traits::index_mask };
+            const bool alive { traits::to_index(slot) == index };
+            slot = traits::construct(
+                next, traits::to_version(slot) + (alive ? 1 : 0));
+        }
+
+        m_free_index = m_entities.empty() ? traits::index_mask : 0;
+        m_size = 0;
     }
 
-    /// Returns this `::world`'s component collection of the given type.
+    /// Returns this `::world`'s component collection of the given type, for
+    /// writing.
+    ///
+    /// If `freeze()` shares the collection, it is copied first, so this must
+    /// not be called concurrently with any other access to the collection.
+    /// `::view`s only resolve the collections they write to this way.
     ///
     /// \tparam T The type of component collection to return.
-    /// \return A reference to the component collection.
+    /// \return A reference to the component collection. Invalidated by
+    ///     `freeze()`.
     template <typename T>
     sparse_set<T>& components()
     {
-        const auto type_id { std::type_index(typeid(T)) };
-        auto it { m_components.find(type_id) };
+        return slot<T>().write();
+    }
+
+    /// Captures the entities and components of this `::world` for reading
+    /// elsewhere, e.g., on a background thread.
+    ///
+    /// No component is copied up front. Instead, the first write to each
+    /// component collection afterwards copies that collection, leaving the
+    /// captured one untouched. References to component collections and
+    /// views obtained before must therefore not be used to write after.
+    ///
+    /// \return The captured state.
+    [[nodiscard]] frozen_world freeze() const;
 
-        if (it == m_components.end()) {
-            it = m_components
-                     .emplace(std::piecewise_construct,
-                         std::forward_as_tuple(type_id),
-                         std::forward_as_tuple(
-                             std::in_place_type_t<sparse_set<T>> {}))
-                    .first;
+    /// Returns an owning `::group` of the given types of components, creating
+    /// it on first use.
+    ///
+    /// From then on, this `::world` keeps every `::entity` associated with
+    /// all of the grouped components packed at the front of each of their
+    /// collections. Components of an owned type must only be inserted and
+    /// erased through this `::world`, and a type can be owned by at most one
+    /// group. Types differing only in `const`-qualification share a group.
+    ///
+    /// \tparam T The types of components to group, `const`-qualified for
+    ///     those only read through the handle.
+    /// \return A handle to the group.
+    /// \throws std::logic_error if a type is already owned by another group.
+    template <typename... T>
+    eecs::group<T...> group()
+    {
+        return eecs::group<T...> { *m_tick,
+            owning_group<std::remove_const_t<T>...>().size,
+            slot<std::remove_const_t<T>>()... };
+    }
+
+    /// Returns a persistent `::query` over each `::entity` associated with
+    /// the given types of components, creating it on first use.
+    ///
+    /// From then on, the matching entities are kept in a packed list, updated
+    /// by hooks on the component collections whenever a component of one of
+    /// the types is inserted or erased, so iterating the query does not
+    /// intersect the collections again. Queries differing only in the
+    /// `const`-qualification of their types share the same list.
+    ///
+    /// \tparam T The types of components that each `::entity` must be
+    ///     associated with, optionally `const`-qualified.
+    /// \return A handle to the query.
+    template <typename... T>
+    eecs::query<T...> query()
+    {
+        using state = typename eecs::query<T...>::state;
+        const u32 id { query_family::id<state>() };
+
+        if (id >= m_queries.size()) {
+            m_queries.resize(id + 1);
+        }
+
+        if (!m_queries[id].has_value()) {
+            m_queries[id] = any { std::in_place_type_t<state> {},
+                slot<std::remove_const_t<T>>()... };
         }
 
-        return any_cast<sparse_set<T>>(it->second);
+        return eecs::query<T...> { *m_tick,
+            unchecked_any_cast<state>(m_queries[id]) };
     }
 
     /// Returns a resource from this `::world`.
@@ -109,42 +550,392 @@ public:
     template <typename T>
     T& resource()
     {
-        const auto type_id { std::type_index(typeid(T)) };
-        const auto it { m_resources.find(type_id) };
+        T* resource { try_resource<T>() };
 
-        if (it == m_resources.end()) {
+        if (resource == nullptr) {
             throw std::out_of_range("Resource not found");
         }
 
-        return any_cast<T>(it->second);
+        return *resource;
+    }
+
+    /// Returns a resource from this `::world`, if it exists.
+    ///
+    /// \tparam T The type of resource to return.
+    /// \return A pointer to the resource, or `nullptr` if it is not found.
+    template <typename T>
+    T* try_resource() noexcept
+    {
+        const u32 id { resource_family::id<T>() };
+
+        if (id >= m_resources.size() || !m_resources[id].has_value()) {
+            return nullptr;
+        }
+
+        return &unchecked_any_cast<T>(m_resources[id]);
+    }
+
+    /// Returns a `::view` over each `::entity` associated with the given
+    /// types of components.
+    ///
+    /// Components yielded for writing are stamped with the current tick, and
+    /// change filters match components stamped during the current frame,
+    /// unless given another tick by `view::since()`.
+    ///
+    /// \tparam T The types of components that each `::entity` must be
+    ///     associated with, optionally `const`-qualified, `::added` or
+    ///     `::changed` filters, and `::exclude` or `::maybe` terms.
+    /// \return A `::view` over the matching entities.
+    template <typename... T>
+    eecs::view<T...> view()
+    {
+        const auto resolve { [this]<typename U>(
+                                 std::type_identity<U> /*unused*/) {
+            if constexpr (std::is_const_v<U>) {
+                return &slot<std::remove_const_t<U>>().read();
+            } else {
+                return &components<U>();
+            }
+        } };
+
+        return eecs::view<T...> { tick(), m_frame_tick - 1,
+            resolve_term<T>(resolve)... };
     }
 
     /// Invokes a function on each `::entity` associated with the given types
     /// of components.
     ///
     /// \tparam T The types of components that each `::entity` must be
-    ///     associated with.
+    ///     associated with, optionally `const`-qualified, `::added` or
+    ///     `::changed` filters, and `::exclude` or `::maybe` terms.
     /// \tparam Fn The type of function to invoke.
     /// \param fn The function to invoke for each matching `::entity`.
     template <typename... T, typename Fn>
     void view(Fn&& fn)
     {
-        auto& first_components {
-            components<std::tuple_element_t<0, std::tuple<T...>>>()
+        view<T...>().each(std::forward<Fn>(fn));
+    }
+
+private:
+    friend class access;
+    friend class frozen_world;
+    friend class snapshot;
+    template <typename Param>
+    friend struct system_param;
+
+    using component_family = family<struct component_tag>;
+    using resource_family = family<struct resource_tag>;
+    using group_family = family<struct group_tag>;
+    using query_family = family<struct query_tag>;
+    using traits = id_traits<entity>;
+
+    /// A type-erased, copy-on-write component collection.
+    struct pool {
+        any components;
+        void (*erase)(world& world, entity entity) { nullptr };
+        void (*clear)(any& components) { nullptr };
+        std::shared_ptr<const void> (*share)(const any& components) {
+            nullptr
         };
-        for (const auto& [entity, _] : first_components) {
-            if ((components<T>().contains(entity) && ...)) {
-                std::forward<Fn>(fn)(entity, components<T>()[entity]...);
+        std::vector<entity> removed;
+        // The ticks of the removals, in the same order.
+        std::vector<u32> removed_ticks;
+    };
+
+    /// Returns the copy-on-write pointer to this `::world`'s component
+    /// collection of the given type, creating the collection on first use.
+    template <typename T>
+    cow_ptr<sparse_set<T>>& slot()
+    {
+        using pointer = cow_ptr<sparse_set<T>>;
+        const u32 id { component_family::id<T>() };
+
+        if (id >= m_pools.size()) {
+            m_pools.resize(id + 1);
+        }
+
+        pool& pool { m_pools[id] };
+        if (!pool.components.has_value()) {
+            pool.components = any { std::in_place_type_t<pointer> {} };
+            pool.erase = [](world& world, const entity entity) {
+                world.erase<T>(entity);
+            };
+            // The collection is cleared rather than replaced, so that its
+            // hooks stay connected and are notified.
+            pool.clear = [](any& components) {
+                unchecked_any_cast<pointer>(components).write().clear();
+            };
+            pool.share = [](const any& components) {
+                return std::shared_ptr<const void> {
+                    any_cast<pointer>(components).share()
+                };
+            };
+        }
+
+        return unchecked_any_cast<pointer>(pool.components);
+    }
+
+    /// Bookkeeping for an owning group.
+    struct group_data {
+        std::size_t size;
+        void (*on_insert)(world& world, group_data& data, entity entity);
+        void (*on_erase)(world& world, group_data& data, entity entity);
+    };
+
+    /// Returns the bookkeeping of the owning group of the given types of
+    /// components, creating the group on first use.
+    template <typename... T>
+    group_data& owning_group()
+    {
+        const u32 id { group_family::id<eecs::group<T...>>() };
+
+        if (id >= m_groups.size()) {
+            m_groups.resize(id + 1);
+        }
+
+        if (m_groups[id] == nullptr) {
+            if (((owner<T>() != nullptr) || ...)) {
+                throw std::logic_error("Component is owned by another group");
+            }
+
+            m_groups[id] = std::make_unique<group_data>(group_data {
+                .size = 0,
+                .on_insert = &world::group_insert<T...>,
+                .on_erase = &world::group_erase<T...> });
+            group_data& data { *m_groups[id] };
+            (set_owner<T>(&data), ...);
+
+            std::vector<entity> candidates;
+            view<const T...>().each(
+                [&candidates](
+                    const entity entity, const T&... /*unused*/) {
+                    candidates.push_back(entity);
+                });
+            for (const entity entity : candidates) {
+                group_insert<T...>(*this, data, entity);
+            }
+        }
+
+        return *m_groups[id];
+    }
+
+    /// Moves an `::entity` into an owning group if it is associated with all
+    /// of the grouped components and not already in the group.
+    template <typename... T>
+    static void group_insert(
+        world& world, group_data& data, const entity entity)
+    {
+        const std::tuple<sparse_set<T>&...> pools { world.components<T>()... };
+        auto& first { std::get<0>(pools) };
+
+        if (!(std::get<sparse_set<T>&>(pools).contains(entity) && ...)
+            || first.index(entity) < data.size) {
+            return;
+        }
+
+        (std::get<sparse_set<T>&>(pools).swap_elements(
+             std::get<sparse_set<T>&>(pools).ids()[data.size], entity),
+            ...);
+        ++data.size;
+    }
+
+    /// Moves an `::entity` out of an owning group if it is in the group.
+    template <typename... T>
+    static void group_erase(
+        world& world, group_data& data, const entity entity)
+    {
+        const std::tuple<sparse_set<T>&...> pools { world.components<T>()... };
+        auto& first { std::get<0>(pools) };
+
+        if (!(std::get<sparse_set<T>&>(pools).contains(entity) && ...)
+            || first.index(entity) >= data.size) {
+            return;
+        }
+
+        --data.size;
+        (std::get<sparse_set<T>&>(pools).swap_elements(
+             std::get<sparse_set<T>&>(pools).ids()[data.size], entity),
+            ...);
+    }
+
+    /// Returns the group owning components of type `T`, if any.
+    template <typename T>
+    [[nodiscard]] group_data* owner() const noexcept
+    {
+        const u32 id { component_family::id<T>() };
+        return id < m_owners.size() ? m_owners[id] : nullptr;
+    }
+
+    /// Sets the group owning components of type `T`.
+    template <typename T>
+    void set_owner(group_data* data)
+    {
+        const u32 id { component_family::id<T>() };
+
+        if (id >= m_owners.size()) {
+            m_owners.resize(id + 1, nullptr);
+        }
+
+        m_owners[id] = data;
+    }
+
+    /// Notifies the group owning components of type `T`, if any, that one
+    /// was inserted.
+    template <typename T>
+    void on_insert(const entity entity)
+    {
+        if (group_data* data { owner<T>() }) {
+            data->on_insert(*this, *data, entity);
+        }
+    }
+
+    /// Notifies the group owning components of type `T`, if any, that one is
+    /// about to be erased.
+    template <typename T>
+    void on_erase(const entity entity)
+    {
+        if (group_data* data { owner<T>() }) {
+            data->on_erase(*this, *data, entity);
+        }
+    }
+
+    /// Returns a new `::world` identifier.
+    static u64 next_id() noexcept
+    {
+        static std::atomic<u64> count { 0 };
+        return count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    u64 m_id { next_id() };
+    std::vector<entity> m_entities;
+    entity m_free_index { traits::index_mask };
+    std::size_t m_size { 0 };
+    // Kept on the heap, so that long-lived handles such as `::group`s read
+    // the current tick even after this `::world` is moved.
+    std::unique_ptr<std::atomic<u32>> m_tick {
+        std::make_unique<std::atomic<u32>>(1)
+    };
+    u32 m_frame_tick { 1 };
+    // Copy-on-write pointers are stored inline in their `::any`, so a
+    // container that never relocates its elements keeps `::group`s pointing
+    // at them valid.
+    std::deque<pool> m_pools;
+    // Small resources are stored inline in their `::any`, so a container
+    // that never relocates its elements keeps references to them valid.
+    std::deque<any> m_resources;
+    std::vector<void (*)(world& world) noexcept> m_event_updates;
+    std::vector<std::unique_ptr<group_data>> m_groups;
+    std::vector<group_data*> m_owners;
+    // Query states are connected to the component collections by address,
+    // so they are kept in a container that never relocates its elements.
+    std::deque<any> m_queries;
+};
+
+/// An immutable capture of the entities and components of a `::world`,
+/// taken by `world::freeze()`.
+///
+/// A `::frozen_world` shares the component collections of its `::world`
+/// until the `::world` writes to them, so it is cheap to take, and it may be
+/// read on any thread while the `::world` moves on. It may also be copied
+/// and released on any thread.
+class frozen_world {
+public:
+    /// Returns the tick of the `::world` when it was frozen.
+    ///
+    /// \return The tick.
+    [[nodiscard]] u32 tick() const noexcept { return m_tick; }
+
+    /// Checks whether an `::entity` was alive when the `::world` was frozen.
+    ///
+    /// \param entity The `::entity` to check.
+    /// \return `true` if the `::entity` was alive; `false` otherwise.
+    [[nodiscard]] bool valid(const entity entity) const noexcept
+    {
+        const auto index { id_traits<eecs::entity>::to_index(entity) };
+        return index < m_entities.size() && m_entities[index] == entity;
+    }
+
+    /// Returns the captured component collection of the given type.
+    ///
+    /// \tparam T The type of component collection to return.
+    /// \return A pointer to the component collection, or `nullptr` if the
+    ///     `::world` had never used it.
+    template <typename T>
+    [[nodiscard]] const sparse_set<T>* components() const noexcept
+    {
+        const u32 id { world::component_family::id<T>() };
+
+        if (id >= m_pools.size()) {
+            return nullptr;
+        }
+
+        return static_cast<const sparse_set<T>*>(m_pools[id].get());
+    }
+
+    /// Invokes a function on each captured `::entity` associated with all of
+    /// the given types of components.
+    ///
+    /// \tparam T The types of components that each `::entity` must be
+    ///     associated with.
+    /// \tparam Fn The type of function to invoke.
+    /// \param fn The function to invoke with the `::entity` followed by a
+    ///     constant reference to each of its components.
+    template <typename... T, typename Fn>
+    void each(Fn&& fn) const
+    {
+        static_assert(sizeof...(T) > 0, "A query needs at least one component");
+
+        const std::tuple<const sparse_set<T>*...> pools { components<T>()... };
+        if (((std::get<const sparse_set<T>*>(pools) == nullptr) || ...)) {
+            return;
+        }
+
+        std::span<const entity> driver { std::get<0>(pools)->ids() };
+        ((std::get<const sparse_set<T>*>(pools)->size() < driver.size()
+                 ? driver = std::get<const sparse_set<T>*>(pools)->ids()
+                 : driver),
+            ...);
+
+        for (const entity entity : driver) {
+            const std::tuple<const T*...> found {
+                std::get<const sparse_set<T>*>(pools)->find(entity)...
+            };
+
+            if (((std::get<const T*>(found) != nullptr) && ...)) {
+                fn(entity, *std::get<const T*>(found)...);
             }
         }
     }
 
 private:
-    entity m_next_entity = 0;
-    std::unordered_map<std::type_index, any> m_components;
-    std::unordered_map<std::type_index, any> m_resources;
+    friend class world;
+    friend class snapshot;
+
+    frozen_world() = default;
+
+    std::vector<entity> m_entities;
+    entity m_free_index { id_traits<entity>::index_mask };
+    u32 m_tick { 0 };
+    std::vector<std::shared_ptr<const void>> m_pools;
 };
 
+inline frozen_world world::freeze() const
+{
+    frozen_world frozen;
+    frozen.m_entities = m_entities;
+    frozen.m_free_index = m_free_index;
+    frozen.m_tick = tick();
+
+    frozen.m_pools.resize(m_pools.size());
+    for (std::size_t id { 0 }; id < m_pools.size(); ++id) {
+        if (m_pools[id].share != nullptr) {
+            frozen.m_pools[id] = m_pools[id].share(m_pools[id].components);
+        }
+    }
+
+    return frozen;
+}
+
 } // namespace eecs
 
 #endif
@@ -1,6 +1,10 @@
 #include "any.hpp"
 
+#include <array>
+#include <memory>
+#include <stdexcept>
 #include <typeindex>
+#include <utility>
 
 #include "gtest/gtest.h"
 
@@ -32,4 +36,43 @@ TEST(AnyTest, CopyConstructor)
     EXPECT_EQ(any1, any2);
 }
 
+TEST(AnyTest, MoveConstructor_InlineValue_ValueIsMoved)
+{
+    // GIVEN
+    static_assert(any::stores_inline<std::unique_ptr<int>>);
+    any any1 { std::make_unique<int>(42) };
+
+    // WHEN
+    any any2 { std::move(any1) };
+
+    // THEN
+    EXPECT_FALSE(any1.has_value()); // NOLINT(bugprone-use-after-move)
+    ASSERT_TRUE(any2.has_value());
+    EXPECT_EQ(*any_cast<std::unique_ptr<int>>(any2), 42);
+}
+
+TEST(AnyTest, MoveConstructor_HeapValue_AddressIsStable)
+{
+    // GIVEN
+    using large = std::array<double, 8>;
+    static_assert(!any::stores_inline<large>);
+    any any1 { large { 1.0 } };
+    const auto* address { &any_cast<large>(any1) };
+
+    // WHEN
+    any any2 { std::move(any1) };
+
+    // THEN
+    EXPECT_EQ(&any_cast<large>(any2), address);
+}
+
+TEST(AnyTest, CopyConstructor_NonCopyableValue_Throws)
+{
+    // GIVEN
+    const any any1 { std::make_unique<int>(42) };
+
+    // WHEN / THEN
+    EXPECT_THROW(any { any1 }, std::logic_error);
+}
+
 } // namespace eecs::test
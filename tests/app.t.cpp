@@ -1,4 +1,10 @@
 #include "app.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+#include "profiler.hpp"
+#include "time.hpp"
 #include "world.hpp"
 
 #include "gtest/gtest.h"
@@ -7,20 +13,184 @@ namespace eecs::test {
 
 namespace {
 
-    void test_system(world& world) { }
+    using namespace std::chrono_literals;
+
+    /// Counts how many times each event ran. Only for testing purposes.
+    struct counters {
+        int startup { 0 };
+        int fixed_update { 0 };
+        int update { 0 };
+        int shutdown { 0 };
+    };
+
+    void count_startup(world& world) { ++world.resource<counters>().startup; }
+
+    void count_fixed_update(world& world)
+    {
+        ++world.resource<counters>().fixed_update;
+    }
+
+    void count_update(world& world) { ++world.resource<counters>().update; }
+
+    void count_shutdown(world& world)
+    {
+        ++world.resource<counters>().shutdown;
+    }
+
+    void exit_on_third_frame(world& world)
+    {
+        if (world.resource<time>().frame == 3) {
+            world.resource<app_exit>().requested = true;
+        }
+    }
 
 } // namespace
 
-// TEST(AppTest, AddSystem)
-// {
-//     // GIVEN
-//     app app;
-//
-//     // WHEN
-//     app.add_system(event::startup, test_system)
-//         .add_system(event::update, test_system)
-//         .add_system(event::shutdown, test_system)
-//         .run();
-// }
+class AppTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        app.set_headless()
+            .add_system(event::startup, count_startup)
+            .add_system(event::fixed_update, count_fixed_update)
+            .add_system(event::update, count_update)
+            .add_system(event::shutdown, count_shutdown);
+        app.world().emplace<counters>();
+    }
+
+    [[nodiscard]] const counters& count()
+    {
+        return app.world().resource<counters>();
+    }
+
+    [[nodiscard]] const time& frame_time()
+    {
+        return app.world().resource<time>();
+    }
+
+    eecs::app app;
+};
+
+TEST_F(AppTest, RunFor_Headless_RunsStartupOnceAndEachFrame)
+{
+    // WHEN
+    app.run_for(3);
+    app.run_for(2);
+
+    // THEN
+    EXPECT_EQ(count().startup, 1);
+    EXPECT_EQ(count().update, 5);
+    EXPECT_EQ(count().shutdown, 0);
+    EXPECT_EQ(frame_time().frame, 5);
+}
+
+TEST_F(AppTest, Step_Headless_NoWorkerThreadsByDefault)
+{
+    // GIVEN
+    eecs::app threaded;
+    threaded.set_headless().set_thread_count(2);
+
+    // WHEN
+    app.step();
+    threaded.step();
+
+    // THEN
+    EXPECT_EQ(app.thread_count(), 0);
+    EXPECT_EQ(count().update, 1);
+    EXPECT_EQ(threaded.thread_count(), 2);
+}
+
+TEST_F(AppTest, Run_ExitRequested_StopsAfterFrame)
+{
+    // GIVEN
+    app.add_system(event::update, exit_on_third_frame);
+
+    // WHEN
+    app.run();
+
+    // THEN
+    EXPECT_EQ(count().update, 3);
+    EXPECT_EQ(count().shutdown, 1);
+}
+
+TEST_F(AppTest, Step_FixedUpdatesKeepUpWithSimulatedTime)
+{
+    // GIVEN
+    app.set_fixed_timestep(10ms);
+
+    // WHEN
+    app.step(25ms);
+
+    // THEN
+    EXPECT_EQ(count().fixed_update, 2);
+    EXPECT_DOUBLE_EQ(frame_time().overstep, 0.5);
+
+    // WHEN
+    app.step(5ms);
+
+    // THEN
+    EXPECT_EQ(count().fixed_update, 3);
+    EXPECT_EQ(frame_time().elapsed, 30ms);
+    EXPECT_EQ(frame_time().delta, 5ms);
+}
+
+TEST_F(AppTest, Step_DefaultTimestep_SixtyFixedUpdatesPerSecond)
+{
+    // WHEN
+    app.step(50ms);
+
+    // THEN
+    EXPECT_EQ(count().fixed_update, 3);
+}
+
+TEST_F(AppTest, Step_TooSlow_ExcessFixedUpdatesAreDropped)
+{
+    // GIVEN
+    app.set_fixed_timestep(10ms, 2);
+
+    // WHEN
+    app.step(100ms);
+    app.step(10ms);
+
+    // THEN
+    EXPECT_EQ(count().fixed_update, 3);
+}
+
+TEST_F(AppTest, RunFor_Profiler_FramesAndSystemsAreRecorded)
+{
+    // GIVEN
+    app.world().emplace<profiler>();
+    static_cast<void>(app.world().create(2));
+
+    // WHEN
+    app.run_for(2);
+
+    // THEN
+    const auto& profiler { app.world().resource<eecs::profiler>() };
+    const auto frames { profiler.frames(1, 2) };
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[1].number, 2);
+    EXPECT_EQ(frames[1].entities, 2);
+    EXPECT_FALSE(profiler.samples(2, 2).empty());
+}
+
+TEST_F(AppTest, Stop_RunsShutdownOnce)
+{
+    // GIVEN
+    app.step();
+
+    // WHEN
+    app.stop();
+    app.stop();
+
+    // THEN
+    EXPECT_EQ(count().shutdown, 1);
+}
+
+TEST_F(AppTest, SetFixedTimestep_ZeroStep_Throws)
+{
+    // WHEN / THEN
+    EXPECT_THROW(app.set_fixed_timestep(0ms), std::invalid_argument);
+}
 
 } // namespace eecs::test
@@ -0,0 +1,205 @@
+#include "archetype_storage.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "entity.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A velocity component. Only for testing purposes.
+    struct velocity {
+        int dx { 0 };
+    };
+
+    /// A component that owns a resource. Only for testing purposes.
+    struct handle {
+        std::shared_ptr<int> resource;
+    };
+
+} // namespace
+
+class ArchetypeStorageTest : public testing::Test {
+protected:
+    archetype_storage storage;
+};
+
+TEST_F(ArchetypeStorageTest, Emplace_ComponentsAreFound)
+{
+    // GIVEN
+    const entity entity { 7 };
+
+    // WHEN
+    storage.emplace<position>(entity, 1);
+    storage.insert(entity, velocity { .dx = 2 });
+
+    // THEN
+    ASSERT_TRUE(storage.contains<position>(entity));
+    ASSERT_TRUE(storage.contains<velocity>(entity));
+    EXPECT_EQ(storage.find<position>(entity)->x, 1);
+    EXPECT_EQ(storage.find<velocity>(entity)->dx, 2);
+    EXPECT_EQ(storage.find<handle>(entity), nullptr);
+}
+
+TEST_F(ArchetypeStorageTest, Emplace_ExistingComponentIsOverwritten)
+{
+    // GIVEN
+    const entity entity { 0 };
+    storage.insert(entity, position { .x = 1 });
+    const std::size_t archetype_count { storage.archetype_count() };
+
+    // WHEN
+    storage.insert(entity, position { .x = 2 });
+
+    // THEN
+    EXPECT_EQ(storage.find<position>(entity)->x, 2);
+    EXPECT_EQ(storage.archetype_count(), archetype_count);
+}
+
+TEST_F(ArchetypeStorageTest, Erase_OtherComponentsAreKept)
+{
+    // GIVEN
+    const entity entity1 { 1 };
+    const entity entity2 { 2 };
+    storage.insert(entity1, position { .x = 1 });
+    storage.insert(entity1, velocity { .dx = 10 });
+    storage.insert(entity2, position { .x = 2 });
+    storage.insert(entity2, velocity { .dx = 20 });
+
+    // WHEN
+    storage.erase<position>(entity1);
+
+    // THEN
+    EXPECT_FALSE(storage.contains<position>(entity1));
+    ASSERT_TRUE(storage.contains<velocity>(entity1));
+    EXPECT_EQ(storage.find<velocity>(entity1)->dx, 10);
+    EXPECT_EQ(storage.find<position>(entity2)->x, 2);
+    EXPECT_EQ(storage.find<velocity>(entity2)->dx, 20);
+}
+
+TEST_F(ArchetypeStorageTest, Contains_StaleEntityIsNotFound)
+{
+    // GIVEN
+    using traits = id_traits<entity>;
+    const entity entity { traits::construct(3, 0) };
+    storage.insert(entity, position { .x = 1 });
+
+    // WHEN
+    const eecs::entity recycled { traits::construct(3, 1) };
+
+    // THEN
+    EXPECT_TRUE(storage.contains<position>(entity));
+    EXPECT_FALSE(storage.contains<position>(recycled));
+}
+
+TEST_F(ArchetypeStorageTest, Remove_ComponentsAreDestroyed)
+{
+    // GIVEN
+    const auto resource { std::make_shared<int>(0) };
+    storage.insert(0, handle { .resource = resource });
+    storage.insert(1, handle { .resource = resource });
+    storage.insert(1, position {});
+    ASSERT_EQ(resource.use_count(), 3);
+
+    // WHEN
+    storage.remove(0);
+    storage.erase<handle>(1);
+
+    // THEN
+    EXPECT_EQ(resource.use_count(), 1);
+    EXPECT_FALSE(storage.contains<handle>(0));
+    EXPECT_TRUE(storage.contains<position>(1));
+}
+
+TEST_F(ArchetypeStorageTest, Clear_ComponentsAreDestroyed)
+{
+    // GIVEN
+    const auto resource { std::make_shared<int>(0) };
+    storage.insert(0, handle { .resource = resource });
+
+    // WHEN
+    storage.clear();
+
+    // THEN
+    EXPECT_EQ(resource.use_count(), 1);
+    EXPECT_FALSE(storage.contains<handle>(0));
+}
+
+TEST_F(ArchetypeStorageTest, Each_VisitsMatchingEntitiesAcrossArchetypes)
+{
+    // GIVEN
+    storage.insert(0, position { .x = 1 });
+    storage.insert(1, position { .x = 2 });
+    storage.insert(1, velocity { .dx = 1 });
+
+    int sum { 0 };
+    storage.each<position>(
+        [&sum](const entity /*unused*/, const position& pos) {
+            sum += pos.x;
+        });
+    ASSERT_EQ(sum, 3);
+
+    // WHEN
+    storage.insert(2, velocity { .dx = 2 });
+    storage.insert(2, handle {});
+    storage.insert(2, position { .x = 4 });
+
+    // THEN
+    sum = 0;
+    storage.each<position>(
+        [&sum](const entity /*unused*/, const position& pos) {
+            sum += pos.x;
+        });
+    EXPECT_EQ(sum, 7);
+
+    std::vector<entity> visited;
+    storage.each<velocity, position>(
+        [&visited](const entity entity, velocity& vel, position& pos) {
+            pos.x += vel.dx;
+            visited.push_back(entity);
+        });
+    EXPECT_EQ(visited.size(), 2);
+    EXPECT_EQ(storage.find<position>(1)->x, 3);
+    EXPECT_EQ(storage.find<position>(2)->x, 6);
+}
+
+TEST_F(ArchetypeStorageTest, Each_ManyEntitiesSpanChunks)
+{
+    // GIVEN
+    constexpr entity entity_count { 10'000 };
+    for (entity entity { 0 }; entity < entity_count; ++entity) {
+        storage.insert(entity, position { .x = static_cast<int>(entity) });
+        storage.insert(entity, velocity { .dx = 1 });
+    }
+
+    // WHEN
+    for (entity entity { 0 }; entity < entity_count; entity += 2) {
+        storage.erase<velocity>(entity);
+    }
+
+    // THEN
+    int count { 0 };
+    storage.each<position, velocity>([&count](const entity entity,
+                                         const position& pos,
+                                         const velocity& /*unused*/) {
+        EXPECT_EQ(entity % 2, 1);
+        EXPECT_EQ(pos.x, static_cast<int>(entity));
+        ++count;
+    });
+    EXPECT_EQ(count, entity_count / 2);
+
+    for (entity entity { 0 }; entity < entity_count; ++entity) {
+        ASSERT_EQ(storage.find<position>(entity)->x, static_cast<int>(entity));
+    }
+}
+
+} // namespace eecs::test
@@ -0,0 +1,51 @@
+#include "arena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+TEST(ArenaTest, Allocate_MemoryIsAligned)
+{
+    // GIVEN
+    arena arena;
+    static_cast<void>(arena.allocate(1, 1));
+
+    // WHEN
+    void* memory { arena.allocate(sizeof(double), alignof(double)) };
+
+    // THEN
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(memory) % alignof(double), 0);
+}
+
+TEST(ArenaTest, Reset_MemoryIsReused)
+{
+    // GIVEN
+    arena arena;
+    void* first { arena.allocate(64, 8) };
+
+    // WHEN
+    arena.reset();
+    void* second { arena.allocate(64, 8) };
+
+    // THEN
+    EXPECT_EQ(first, second);
+}
+
+TEST(ArenaTest, Allocate_LargerThanBlock_MemoryIsAllocated)
+{
+    // GIVEN
+    arena arena;
+
+    // WHEN
+    auto* memory { static_cast<std::byte*>(
+        arena.allocate(arena::block_size * 2, 16)) };
+
+    // THEN
+    ASSERT_NE(memory, nullptr);
+    memory[arena::block_size * 2 - 1] = std::byte { 1 };
+}
+
+} // namespace eecs::test
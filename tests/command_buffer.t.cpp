@@ -0,0 +1,136 @@
+#include "command_buffer.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "entity.hpp"
+#include "schedule.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A name component with a non-trivial destructor. Only for testing
+    /// purposes.
+    struct name {
+        std::string value;
+    };
+
+} // namespace
+
+class CommandBufferTest : public testing::Test {
+protected:
+    world world;
+    command_buffer commands;
+};
+
+TEST_F(CommandBufferTest, Flush_PendingEntity_IsCreatedWithComponents)
+{
+    // GIVEN
+    const auto pending { commands.create() };
+    commands.insert(pending, position { .x = 7 });
+    commands.emplace<name>(pending, "pending");
+
+    // WHEN
+    commands.flush(world);
+
+    // THEN
+    ASSERT_EQ(world.components<position>().size(), 1);
+    const entity entity { world.components<position>().ids()[0] };
+    EXPECT_TRUE(world.valid(entity));
+    EXPECT_EQ(world.components<position>()[entity].x, 7);
+    EXPECT_EQ(world.components<name>()[entity].value, "pending");
+    EXPECT_TRUE(commands.empty());
+}
+
+TEST_F(CommandBufferTest, Flush_DuringIteration_ChangesAreDeferred)
+{
+    // GIVEN
+    for (int i = 0; i < 10; ++i) {
+        world.insert(world.create(), position { .x = i });
+    }
+
+    // WHEN
+    world.view<position>([this](const entity entity, const position& pos) {
+        if (pos.x % 2 == 0) {
+            commands.erase<position>(entity);
+        } else {
+            commands.insert(entity, name { .value = "odd" });
+        }
+    });
+    const auto size_before_flush { world.components<position>().size() };
+    commands.flush(world);
+
+    // THEN
+    EXPECT_EQ(size_before_flush, 10);
+    EXPECT_EQ(world.components<position>().size(), 5);
+    EXPECT_EQ(world.components<name>().size(), 5);
+}
+
+TEST_F(CommandBufferTest, Flush_DestroyedEntity_LaterChangesAreDropped)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    commands.destroy(entity);
+    commands.flush(world);
+
+    // WHEN
+    commands.insert(entity, position { .x = 1 });
+    commands.flush(world);
+
+    // THEN
+    EXPECT_FALSE(world.valid(entity));
+    EXPECT_TRUE(world.components<position>().empty());
+}
+
+TEST_F(CommandBufferTest, Flush_HookRecordsIntoBuffer_ChangeIsKeptForNextFlush)
+{
+    // GIVEN
+    world.on_construct<position>(
+        { [](void* context, const entity entity) {
+             static_cast<command_buffer*>(context)->insert(
+                 entity, name { .value = "spawned" });
+         },
+            &commands });
+    const entity entity { world.create() };
+    commands.insert(entity, position {});
+
+    // WHEN
+    commands.flush(world);
+
+    // THEN
+    EXPECT_FALSE(world.components<name>().contains(entity));
+    ASSERT_FALSE(commands.empty());
+    commands.flush(world);
+    EXPECT_EQ(world.components<name>()[entity].value, "spawned");
+    EXPECT_TRUE(commands.empty());
+}
+
+TEST_F(CommandBufferTest, Run_ScheduleFlushesWorldCommandBuffer)
+{
+    // GIVEN
+    schedule schedule;
+    schedule.add_system([](eecs::world& world) {
+        auto& commands { world.resource<command_buffer>() };
+        commands.insert(commands.create(), position {});
+    });
+    world.emplace<command_buffer>();
+
+    // WHEN
+    schedule.run(world);
+
+    // THEN
+    EXPECT_EQ(world.components<position>().size(), 1);
+}
+
+} // namespace eecs::test
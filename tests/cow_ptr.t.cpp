@@ -0,0 +1,53 @@
+#include "cow_ptr.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+TEST(CowPtrTest, Write_Unshared_ObjectIsNotCopied)
+{
+    // GIVEN
+    cow_ptr<std::vector<int>> pointer;
+    const std::vector<int>* before { &pointer.read() };
+
+    // WHEN
+    pointer.write().push_back(1);
+
+    // THEN
+    EXPECT_EQ(&pointer.read(), before);
+    EXPECT_EQ(pointer.read(), std::vector<int> { 1 });
+}
+
+TEST(CowPtrTest, Write_Shared_SharedObjectIsUnchanged)
+{
+    // GIVEN
+    cow_ptr<std::vector<int>> pointer;
+    pointer.write().push_back(1);
+    const std::shared_ptr<const std::vector<int>> shared { pointer.share() };
+
+    // WHEN
+    pointer.write().push_back(2);
+
+    // THEN
+    EXPECT_EQ(*shared, std::vector<int> { 1 });
+    EXPECT_EQ(pointer.read(), (std::vector<int> { 1, 2 }));
+}
+
+TEST(CowPtrTest, Shared_AfterRelease_IsFalse)
+{
+    // GIVEN
+    cow_ptr<std::vector<int>> pointer;
+    auto shared { pointer.share() };
+    ASSERT_TRUE(pointer.shared());
+
+    // WHEN
+    shared.reset();
+
+    // THEN
+    EXPECT_FALSE(pointer.shared());
+}
+
+} // namespace eecs::test
@@ -0,0 +1,140 @@
+#include "events.hpp"
+
+#include <vector>
+
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A damage event. Only for testing purposes.
+    struct damage {
+        int amount { 0 };
+    };
+
+    /// Reads every unread event into a vector. Only for testing purposes.
+    std::vector<int> drain(
+        const events<damage>& channel, events<damage>::reader& reader)
+    {
+        std::vector<int> amounts;
+        channel.each(reader, [&amounts](const damage& event) {
+            amounts.push_back(event.amount);
+        });
+        return amounts;
+    }
+
+} // namespace
+
+TEST(EventsTest, Read_EachReaderSeesEveryEventOnce)
+{
+    // GIVEN
+    events<damage> channel;
+    events<damage>::reader first;
+    events<damage>::reader second;
+    channel.send(damage { .amount = 1 });
+    channel.emplace(2);
+
+    // WHEN
+    const std::vector<int> read { drain(channel, first) };
+    channel.send(damage { .amount = 3 });
+
+    // THEN
+    EXPECT_EQ(read, (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(drain(channel, first), std::vector<int> { 3 });
+    EXPECT_EQ(drain(channel, second), (std::vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(channel.unread(first), 0);
+}
+
+TEST(EventsTest, Update_EventsLastTwoFrames)
+{
+    // GIVEN
+    events<damage> channel;
+    events<damage>::reader reader;
+    channel.send(damage { .amount = 1 });
+
+    // WHEN
+    channel.update();
+    channel.send(damage { .amount = 2 });
+
+    // THEN
+    const auto runs { channel.read(reader) };
+    ASSERT_EQ(runs[0].size(), 1);
+    ASSERT_EQ(runs[1].size(), 1);
+    EXPECT_EQ(runs[0][0].amount, 1);
+    EXPECT_EQ(runs[1][0].amount, 2);
+}
+
+TEST(EventsTest, Update_LaggingReader_MissesDroppedEvents)
+{
+    // GIVEN
+    events<damage> channel;
+    events<damage>::reader reader;
+    channel.send(damage { .amount = 1 });
+    channel.update();
+    channel.send(damage { .amount = 2 });
+
+    // WHEN
+    channel.update();
+
+    // THEN
+    EXPECT_EQ(drain(channel, reader), std::vector<int> { 2 });
+}
+
+TEST(EventsTest, Update_MemoryIsReused)
+{
+    // GIVEN
+    events<damage> channel;
+    events<damage>::reader reader;
+    for (int frame { 0 }; frame < 2; ++frame) {
+        for (int i { 0 }; i < 100; ++i) {
+            channel.send(damage { .amount = i });
+        }
+        channel.update();
+    }
+    const damage* older { channel.read(reader)[0].data() };
+
+    // WHEN
+    channel.update();
+    for (int i { 0 }; i < 100; ++i) {
+        channel.send(damage { .amount = i });
+    }
+
+    // THEN
+    EXPECT_EQ(channel.read(reader)[1].data(), older);
+}
+
+TEST(EventsTest, Latest_SkipsEarlierEvents)
+{
+    // GIVEN
+    events<damage> channel;
+    channel.send(damage { .amount = 1 });
+
+    // WHEN
+    events<damage>::reader reader { channel.latest() };
+    channel.send(damage { .amount = 2 });
+
+    // THEN
+    EXPECT_EQ(drain(channel, reader), std::vector<int> { 2 });
+}
+
+TEST(EventsTest, AdvanceTick_WorldChannelsAreUpdated)
+{
+    // GIVEN
+    world world;
+    events<damage>& channel { world.add_events<damage>() };
+    events<damage>::reader reader;
+    channel.send(damage { .amount = 1 });
+
+    // WHEN
+    world.advance_tick();
+    world.advance_tick();
+
+    // THEN
+    EXPECT_EQ(&world.add_events<damage>(), &channel);
+    EXPECT_EQ(channel.unread(reader), 0);
+}
+
+} // namespace eecs::test
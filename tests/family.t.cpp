@@ -0,0 +1,41 @@
+#include "family.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    struct test_family;
+    struct other_family;
+
+} // namespace
+
+TEST(FamilyTest, Id_SameType_IdIsStable)
+{
+    // GIVEN
+    const u32 id { family<test_family>::id<int>() };
+
+    // WHEN
+    const u32 other_id { family<test_family>::id<int>() };
+
+    // THEN
+    EXPECT_EQ(id, other_id);
+}
+
+TEST(FamilyTest, Id_DifferentTypes_IdsAreSequential)
+{
+    // GIVEN
+    const u32 first { family<other_family>::id<int>() };
+
+    // WHEN
+    const u32 second { family<other_family>::id<float>() };
+    const u32 third { family<other_family>::id<double>() };
+
+    // THEN
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 1);
+    EXPECT_EQ(third, 2);
+}
+
+} // namespace eecs::test
@@ -0,0 +1,148 @@
+#include "group.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A velocity component. Only for testing purposes.
+    struct velocity {
+        int dx { 0 };
+    };
+
+} // namespace
+
+class GroupTest : public testing::Test {
+protected:
+    world world;
+};
+
+TEST_F(GroupTest, Group_ExistingEntitiesArePacked)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    const entity entity3 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity3, position { .x = 3 });
+    world.insert(entity3, velocity { .dx = 30 });
+
+    // WHEN
+    const auto group { world.group<position, velocity>() };
+
+    // THEN
+    ASSERT_EQ(group.size(), 1);
+    EXPECT_TRUE(group.contains(entity3));
+    EXPECT_EQ(world.components<position>().ids()[0], entity3);
+    EXPECT_EQ(world.components<velocity>().ids()[0], entity3);
+}
+
+TEST_F(GroupTest, InsertAndErase_GroupIsKeptInSync)
+{
+    // GIVEN
+    const auto group { world.group<position, velocity>() };
+    std::vector<entity> entities;
+    for (int i = 0; i < 4; ++i) {
+        entities.push_back(world.create());
+        world.insert(entities.back(), position { .x = i });
+    }
+
+    // WHEN
+    world.insert(entities[1], velocity { .dx = 1 });
+    world.insert(entities[3], velocity { .dx = 3 });
+    world.erase<position>(entities[1]);
+
+    // THEN
+    ASSERT_EQ(group.size(), 1);
+    EXPECT_TRUE(group.contains(entities[3]));
+    EXPECT_FALSE(group.contains(entities[1]));
+}
+
+TEST_F(GroupTest, Each_ComponentsAreVisitedInLockStep)
+{
+    // GIVEN
+    const auto group { world.group<position, velocity>() };
+    for (int i = 0; i < 8; ++i) {
+        const entity entity { world.create() };
+        world.insert(entity, position { .x = i });
+        if (i % 2 == 0) {
+            world.insert(entity, velocity { .dx = i });
+        }
+    }
+
+    // WHEN
+    group.each([](const entity /*unused*/, position& pos, const velocity& vel) {
+        pos.x += vel.dx;
+    });
+
+    // THEN
+    EXPECT_EQ(group.size(), 4);
+    world.view<position>([](const entity entity, const position& pos) {
+        EXPECT_EQ(pos.x, entity % 2 == 0 ? 2 * entity : entity);
+    });
+}
+
+TEST_F(GroupTest, Each_WrittenComponentsAreChanged)
+{
+    // GIVEN
+    const auto group { world.group<position, velocity>() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.insert(entity, velocity { .dx = 1 });
+    world.advance_tick();
+    ASSERT_FALSE(world.view<changed<position>>().contains(entity));
+
+    // WHEN
+    group.each([](const eecs::entity /*unused*/, position& pos,
+                   const velocity& vel) { pos.x += vel.dx; });
+
+    // THEN
+    EXPECT_TRUE(world.view<changed<position>>().contains(entity));
+    EXPECT_TRUE(world.view<changed<velocity>>().contains(entity));
+}
+
+TEST_F(GroupTest, Each_ConstTypes_FrozenCollectionsAreShared)
+{
+    // GIVEN
+    const auto group { world.group<position, const velocity>() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.insert(entity, velocity { .dx = 1 });
+    const frozen_world frozen { world.freeze() };
+
+    // WHEN
+    group.each([](const eecs::entity /*unused*/, position& pos,
+                   const velocity& vel) { pos.x += vel.dx; });
+
+    // THEN
+    const frozen_world again { world.freeze() };
+    EXPECT_NE(again.components<position>(), frozen.components<position>());
+    EXPECT_EQ(again.components<velocity>(), frozen.components<velocity>());
+    const auto shared { world.group<position, velocity>() };
+    EXPECT_TRUE(shared.contains(entity));
+}
+
+TEST_F(GroupTest, Group_OwnedByAnotherGroup_Throws)
+{
+    // GIVEN
+    static_cast<void>(world.group<position, velocity>());
+
+    // WHEN / THEN
+    EXPECT_THROW(
+        static_cast<void>(world.group<velocity, position>()), std::logic_error);
+}
+
+} // namespace eecs::test
@@ -0,0 +1,133 @@
+#include "profiler.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "schedule.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    using namespace std::chrono_literals;
+
+    void empty_system(world& /*world*/) { }
+
+} // namespace
+
+class ProfilerTest : public testing::Test {
+protected:
+    profiler::clock::time_point start { profiler::clock::now() };
+};
+
+TEST_F(ProfilerTest, Record_SamplesBelongToCurrentFrame)
+{
+    // GIVEN
+    profiler profiler;
+
+    // WHEN
+    profiler.begin_frame(1);
+    profiler.record("physics", start, start + 2ms);
+    profiler.record("physics", start, start + 4ms);
+    profiler.end_frame(10);
+    profiler.begin_frame(2);
+    profiler.record("render", start, start + 1ms);
+    profiler.end_frame(12);
+
+    // THEN
+    EXPECT_EQ(profiler.samples(1, 1).size(), 2);
+    ASSERT_EQ(profiler.frames(2, 2).size(), 1);
+    EXPECT_EQ(profiler.frames(2, 2)[0].entities, 12);
+
+    const auto summaries { profiler.summarize(1, 2) };
+    ASSERT_EQ(summaries.size(), 2);
+    EXPECT_EQ(summaries[0].name, "physics");
+    EXPECT_EQ(summaries[0].calls, 2);
+    EXPECT_EQ(summaries[0].total, 6ms);
+    EXPECT_EQ(summaries[0].longest, 4ms);
+    EXPECT_EQ(summaries[1].name, "render");
+}
+
+TEST_F(ProfilerTest, Record_OverCapacity_OldestSamplesAreDropped)
+{
+    // GIVEN
+    profiler profiler { 2, 1 };
+
+    // WHEN
+    profiler.record("first", start, start);
+    profiler.record("second", start, start);
+    profiler.record("third", start, start);
+
+    // THEN
+    const auto samples { profiler.samples(0, 0) };
+    ASSERT_EQ(samples.size(), 2);
+    EXPECT_EQ(samples[0].name, "second");
+    EXPECT_EQ(samples[1].name, "third");
+}
+
+TEST_F(ProfilerTest, WriteTrace_WritesTraceEvents)
+{
+    // GIVEN
+    profiler profiler;
+    profiler.begin_frame(1);
+    profiler.record("a \"quoted\" name", start, start + 1ms);
+    profiler.end_frame(0);
+
+    // WHEN
+    std::ostringstream out;
+    profiler.write_trace(out, 1, 1);
+
+    // THEN
+    const std::string trace { out.str() };
+    EXPECT_EQ(trace.find(R"({"displayTimeUnit":"ms","traceEvents":[)"), 0);
+    EXPECT_NE(trace.find(R"("name":"frame")"), std::string::npos);
+    EXPECT_NE(trace.find(R"("name":"a \"quoted\" name")"), std::string::npos);
+    EXPECT_NE(trace.find(R"("dur":1000)"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 2), "]}");
+}
+
+TEST_F(ProfilerTest, ScheduleRun_SystemsAreRecorded)
+{
+    // GIVEN
+    world world;
+    world.emplace<profiler>();
+    thread_pool pool { 2 };
+    schedule schedule;
+    schedule.add_system(empty_system, "first")
+        .add_system(empty_system, "second");
+
+    // WHEN
+    schedule.run(world, pool);
+    schedule.run(world);
+
+    // THEN
+    const auto summaries { world.resource<profiler>().summarize(0, 0) };
+    ASSERT_EQ(summaries.size(), 2);
+    EXPECT_EQ(summaries[0].calls + summaries[1].calls, 4);
+}
+
+TEST_F(ProfilerTest, ScheduleRun_UnnamedSystemsAreKeptApart)
+{
+    // GIVEN
+    world world;
+    world.emplace<profiler>();
+    schedule schedule;
+    schedule.add_system(empty_system).add_system(empty_system);
+
+    // WHEN
+    schedule.run(world);
+
+    // THEN
+    const auto summaries { world.resource<profiler>().summarize(0, 0) };
+    ASSERT_EQ(summaries.size(), 2);
+    EXPECT_NE(summaries[0].name, summaries[1].name);
+    EXPECT_EQ(summaries[0].calls, 1);
+    EXPECT_EQ(summaries[1].calls, 1);
+}
+
+} // namespace eecs::test
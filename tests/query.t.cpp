@@ -0,0 +1,155 @@
+#include "query.hpp"
+
+#include <vector>
+
+#include "entity.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A velocity component. Only for testing purposes.
+    struct velocity {
+        int dx { 0 };
+    };
+
+} // namespace
+
+class QueryTest : public testing::Test {
+protected:
+    world world;
+};
+
+TEST_F(QueryTest, Query_ExistingEntitiesMatch)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity2, velocity { .dx = 20 });
+
+    // WHEN
+    const auto query { world.query<position, velocity>() };
+
+    // THEN
+    ASSERT_EQ(query.size(), 1);
+    EXPECT_TRUE(query.contains(entity2));
+    EXPECT_FALSE(query.contains(entity1));
+}
+
+TEST_F(QueryTest, InsertAndErase_QueryIsKeptInSync)
+{
+    // GIVEN
+    const auto query { world.query<position, velocity>() };
+    std::vector<entity> entities;
+    for (int i = 0; i < 4; ++i) {
+        entities.push_back(world.create());
+        world.insert(entities.back(), position { .x = i });
+    }
+
+    // WHEN
+    world.insert(entities[1], velocity { .dx = 1 });
+    world.emplace<velocity>(entities[2], 2);
+    world.insert(entities[3], velocity { .dx = 3 });
+    world.erase<position>(entities[1]);
+    world.destroy(entities[3]);
+
+    // THEN
+    ASSERT_EQ(query.size(), 1);
+    EXPECT_TRUE(query.contains(entities[2]));
+    const auto shared { world.query<const position, velocity>() };
+    EXPECT_TRUE(shared.contains(entities[2]));
+}
+
+TEST_F(QueryTest, Each_ComponentsAreVisitedAndStamped)
+{
+    // GIVEN
+    const auto query { world.query<position, const velocity>() };
+    for (int i = 0; i < 4; ++i) {
+        const entity entity { world.create() };
+        world.insert(entity, position { .x = i });
+        if (i % 2 == 0) {
+            world.insert(entity, velocity { .dx = 10 });
+        }
+    }
+    world.advance_tick();
+
+    // WHEN
+    query.each([](const entity /*entity*/, position& position,
+                   const velocity& velocity) { position.x += velocity.dx; });
+
+    // THEN
+    const auto& positions { world.components<position>() };
+    int moved { 0 };
+    for (const entity entity : world.query<position, velocity>().ids()) {
+        EXPECT_GE(positions[entity].x, 10);
+        EXPECT_EQ(positions.ticks()[positions.index(entity)].changed,
+            world.tick());
+        ++moved;
+    }
+    EXPECT_EQ(moved, 2);
+}
+
+TEST_F(QueryTest, Each_AfterAdvanceTick_ComponentsAreChanged)
+{
+    // GIVEN
+    const auto query { world.query<position>() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.advance_tick();
+    world.advance_tick();
+
+    // WHEN
+    query.each([](const eecs::entity /*unused*/, position& position) {
+        ++position.x;
+    });
+
+    // THEN
+    EXPECT_TRUE(world.view<changed<position>>().contains(entity));
+}
+
+TEST_F(QueryTest, Freeze_QueryFollowsCopiedCollections)
+{
+    // GIVEN
+    const auto query { world.query<position, velocity>() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    const frozen_world frozen { world.freeze() };
+
+    // WHEN
+    world.insert(entity, velocity {});
+
+    // THEN
+    EXPECT_TRUE(query.contains(entity));
+    EXPECT_FALSE(frozen.components<velocity>()->contains(entity));
+}
+
+TEST_F(QueryTest, Clear_QueryIsEmptied)
+{
+    // GIVEN
+    const auto query { world.query<position, velocity>() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.insert(entity, velocity {});
+
+    // WHEN
+    world.clear();
+
+    // THEN
+    EXPECT_TRUE(query.empty());
+    const auto recreated { world.create() };
+    world.insert(recreated, position {});
+    world.insert(recreated, velocity {});
+    EXPECT_TRUE(query.contains(recreated));
+}
+
+} // namespace eecs::test
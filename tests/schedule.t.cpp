@@ -1,6 +1,11 @@
 #include "schedule.hpp"
 
+#include <stdexcept>
+#include <vector>
+
+#include "access.hpp"
 #include "entity.hpp"
+#include "thread_pool.hpp"
 #include "world.hpp"
 
 #include "gtest/gtest.h"
@@ -29,6 +34,52 @@ namespace {
         world.insert(entity2, component);
     }
 
+    /// A log of the order systems ran in. Only for testing purposes.
+    struct run_log {
+        std::vector<int> order;
+    };
+
+    struct position {
+        int x = 0;
+    };
+
+    struct velocity {
+        int dx = 0;
+    };
+
+    void spawn(world& world)
+    {
+        for (int i = 0; i < 100; ++i) {
+            const entity entity = world.create();
+            world.insert(entity, position { .x = i });
+            world.insert(entity, velocity { .dx = 1 });
+        }
+    }
+
+    void integrate(world& world)
+    {
+        world.view<position, velocity>(
+            [](const entity /*unused*/, position& pos, const velocity& vel) {
+                pos.x += vel.dx;
+            });
+    }
+
+    void log_first(world& world)
+    {
+        world.resource<run_log>().order.push_back(1);
+    }
+
+    void log_second(world& world)
+    {
+        world.resource<run_log>().order.push_back(2);
+    }
+
+    void log_and_throw(world& world)
+    {
+        world.resource<run_log>().order.push_back(1);
+        throw std::runtime_error { "System failed" };
+    }
+
 } // namespace
 
 TEST(ScheduleTest, Run_SystemsRanSequentially)
@@ -47,4 +98,75 @@ TEST(ScheduleTest, Run_SystemsRanSequentially)
     ASSERT_EQ(components.size(), 3);
 }
 
+TEST(ScheduleTest, RunOnPool_ConflictingSystemsRanInOrder)
+{
+    // GIVEN
+    schedule schedule;
+    schedule.add_system<writes_resource<run_log>>(log_first)
+        .add_system<reads<position>>(integrate)
+        .add_system<writes_resource<run_log>>(log_second);
+
+    world world;
+    world.emplace<run_log>();
+    thread_pool pool { 4 };
+
+    // WHEN
+    schedule.run(world, pool);
+
+    // THEN
+    EXPECT_EQ(world.resource<run_log>().order, (std::vector<int> { 1, 2 }));
+}
+
+TEST(ScheduleTest, RunOnPool_ExclusiveSystemRanBeforeDependents)
+{
+    // GIVEN
+    schedule schedule;
+    schedule.add_system(spawn).add_system<writes<position>, reads<velocity>>(
+        integrate);
+
+    world world;
+    thread_pool pool { 4 };
+
+    // WHEN
+    schedule.run(world, pool);
+
+    // THEN
+    const sparse_set<position>& positions = world.components<position>();
+    ASSERT_EQ(positions.size(), 100);
+    for (const entity entity : positions.ids()) {
+        EXPECT_EQ(positions[entity].x, static_cast<int>(entity) + 1);
+    }
+}
+
+TEST(ScheduleTest, RunOnPool_SystemThrows_DependentsAreSkipped)
+{
+    // GIVEN
+    schedule schedule;
+    schedule.add_system<writes_resource<run_log>>(log_and_throw)
+        .add_system<writes_resource<run_log>>(log_second);
+
+    world world;
+    world.emplace<run_log>();
+    thread_pool pool { 4 };
+
+    // WHEN / THEN
+    EXPECT_THROW(schedule.run(world, pool), std::runtime_error);
+    EXPECT_EQ(world.resource<run_log>().order, (std::vector<int> { 1 }));
+}
+
+TEST(AccessTest, ConflictsWith_DisjointAccesses_DoNotConflict)
+{
+    // GIVEN
+    const access lhs = access::of<writes<position>, reads<velocity>>();
+    const access rhs = access::of<reads<velocity>, writes_resource<run_log>>();
+
+    // WHEN
+    const bool conflicts = lhs.conflicts_with(rhs);
+
+    // THEN
+    EXPECT_FALSE(conflicts);
+    EXPECT_TRUE(lhs.conflicts_with(access::of<reads<position>>()));
+    EXPECT_TRUE(lhs.conflicts_with(access {}));
+}
+
 } // namespace eecs::test
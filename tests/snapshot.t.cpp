@@ -0,0 +1,181 @@
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "entity.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        float x { 0.0 };
+        float y { 0.0 };
+        auto operator<=>(const position&) const = default;
+    };
+
+    /// A health component. Only for testing purposes.
+    struct health {
+        int value { 0 };
+    };
+
+} // namespace
+
+class SnapshotTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        snapshot.component<position>("position").component<health>("health");
+        const auto* info {
+            testing::UnitTest::GetInstance()->current_test_info()
+        };
+        path = std::filesystem::temp_directory_path()
+            / (std::string { "eecs_" } + info->name() + ".bin");
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    world source;
+    world target;
+    snapshot snapshot;
+    std::filesystem::path path;
+};
+
+TEST_F(SnapshotTest, SaveAndLoad_EntitiesAndComponentsAreRestored)
+{
+    // GIVEN
+    const std::vector<entity> entities { source.create(4) };
+    source.destroy(entities[1]);
+    source.insert(entities[0], position { .x = 1.0, .y = 2.0 });
+    source.insert(entities[2], position { .x = 3.0, .y = 4.0 });
+    source.insert(entities[3], health { .value = 9 });
+
+    // WHEN
+    snapshot.save(source, path);
+    snapshot.load(target, path);
+
+    // THEN
+    EXPECT_TRUE(target.valid(entities[0]));
+    EXPECT_FALSE(target.valid(entities[1]));
+    EXPECT_EQ(target.components<position>().size(), 2);
+    EXPECT_EQ(target.components<position>()[entities[2]],
+        (position { .x = 3.0, .y = 4.0 }));
+    EXPECT_EQ(target.components<health>()[entities[3]].value, 9);
+    EXPECT_EQ(target.size(), 3);
+
+    const entity recycled { target.create() };
+    EXPECT_EQ(id_traits<entity>::to_index(recycled), 1);
+    EXPECT_NE(recycled, entities[1]);
+}
+
+TEST_F(SnapshotTest, Restore_OwningGroupsAreRebuilt)
+{
+    // GIVEN
+    const entity entity { source.create() };
+    source.insert(entity, position {});
+    source.insert(entity, health {});
+    const auto group { target.group<position, health>() };
+
+    // WHEN
+    snapshot.restore(target, snapshot.capture(source));
+
+    // THEN
+    EXPECT_EQ(group.size(), 1);
+    EXPECT_TRUE(group.contains(entity));
+}
+
+TEST_F(SnapshotTest, Restore_UnregisteredTypesAreSkipped)
+{
+    // GIVEN
+    const entity entity { source.create() };
+    source.insert(entity, position { .x = 5.0 });
+    source.insert(entity, health { .value = 1 });
+    eecs::snapshot partial;
+    partial.component<health>("health");
+
+    // WHEN
+    partial.restore(target, snapshot.capture(source));
+
+    // THEN
+    EXPECT_TRUE(target.components<position>().empty());
+    EXPECT_EQ(target.components<health>()[entity].value, 1);
+}
+
+TEST_F(SnapshotTest, Restore_MalformedImage_Throws)
+{
+    // GIVEN
+    source.insert(source.create(), position {});
+    std::vector<std::byte> image { snapshot.capture(source) };
+    target.insert(target.create(), health {});
+
+    // WHEN
+    image.resize(image.size() / 2);
+
+    // THEN
+    EXPECT_THROW(snapshot.restore(target, image), std::runtime_error);
+    EXPECT_FALSE(target.valid(0));
+    EXPECT_THROW(snapshot.restore(target, std::vector<std::byte>(64)),
+        std::runtime_error);
+}
+
+TEST_F(SnapshotTest, Restore_CyclicFreeList_Throws)
+{
+    // GIVEN
+    using traits = id_traits<entity>;
+    const entity entity1 { source.create() };
+    const entity entity2 { source.create() };
+    source.destroy(entity1);
+    source.destroy(entity2);
+    std::vector<std::byte> image { snapshot.capture(source) };
+
+    // WHEN
+    const entity last { traits::construct(traits::index_mask, 1) };
+    const entity looped { traits::construct(traits::to_index(entity2), 1) };
+    const auto* bytes { reinterpret_cast<const std::byte*>(&last) };
+    const auto slot { std::ranges::search(image,
+        std::span<const std::byte> { bytes, sizeof(entity) }) };
+    ASSERT_FALSE(slot.empty());
+    std::memcpy(slot.data(), &looped, sizeof(entity));
+
+    // THEN
+    EXPECT_THROW(snapshot.restore(target, image), std::runtime_error);
+    EXPECT_EQ(target.size(), 0);
+}
+
+TEST_F(SnapshotTest, SaveOnPool_FileIsWritten)
+{
+    // GIVEN
+    const entity entity { source.create() };
+    source.insert(entity, health { .value = 3 });
+    thread_pool pool { 1 };
+
+    // WHEN
+    snapshot.save(source, path, pool).get();
+    snapshot.load(target, path);
+
+    // THEN
+    EXPECT_EQ(target.components<health>()[entity].value, 3);
+}
+
+TEST_F(SnapshotTest, Component_DuplicateName_Throws)
+{
+    // GIVEN
+    // ...
+
+    // WHEN / THEN
+    EXPECT_THROW(snapshot.component<health>("position"), std::logic_error);
+}
+
+} // namespace eecs::test
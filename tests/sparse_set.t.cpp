@@ -1,5 +1,8 @@
 #include "sparse_set.hpp"
 
+#include <vector>
+
+#include "entity.hpp"
 #include "types.hpp"
 
 #include "gtest/gtest.h"
@@ -58,4 +61,254 @@ TEST(SparseSetTest, Erase_ValueIsRemoved)
     EXPECT_TRUE(set.empty());
 }
 
+TEST(SparseSetTest, Insert_ForDistantIds_ValuesArePresent)
+{
+    // GIVEN
+    const u32 low_id = 7;
+    const u32 high_id = 1'000'000;
+
+    sparse_set<float> set;
+
+    // WHEN
+    set.insert(low_id, 1.0);
+    set.insert(high_id, 2.0);
+
+    // THEN
+    EXPECT_EQ(set[low_id], 1.0);
+    EXPECT_EQ(set[high_id], 2.0);
+    EXPECT_FALSE(set.contains(high_id - 1));
+    EXPECT_FALSE(set.contains(high_id + sparse_set<float>::page_size));
+}
+
+TEST(SparseSetTest, CopyConstructor_CopyIsIndependent)
+{
+    // GIVEN
+    const u32 id = 42;
+
+    sparse_set<float> set;
+    set.insert(id, 100.0);
+
+    // WHEN
+    sparse_set<float> copy { set };
+    set.erase(id);
+
+    // THEN
+    ASSERT_TRUE(copy.contains(id));
+    EXPECT_EQ(copy[id], 100.0);
+    EXPECT_FALSE(set.contains(id));
+}
+
+TEST(SparseSetTest, Contains_StaleVersion_ValueIsAbsent)
+{
+    // GIVEN
+    using traits = id_traits<u32>;
+    const u32 id = traits::construct(42, 1);
+    const u32 stale_id = traits::construct(42, 0);
+
+    sparse_set<float> set;
+    set.insert(id, 100.0);
+
+    // WHEN
+    const bool contains = set.contains(stale_id);
+
+    // THEN
+    EXPECT_FALSE(contains);
+    EXPECT_TRUE(set.contains(id));
+}
+
+TEST(SparseSetTest, Insert_OtherVersion_ElementIsReplaced)
+{
+    // GIVEN
+    using traits = id_traits<u32>;
+    const u32 id = traits::construct(0, 0);
+    const u32 other_id = traits::construct(0, 1);
+
+    sparse_set<float> set;
+    set.insert(id, 100.0);
+
+    // WHEN
+    set.insert(other_id, 200.0);
+
+    // THEN
+    EXPECT_FALSE(set.contains(id));
+    ASSERT_TRUE(set.contains(other_id));
+    EXPECT_EQ(set[other_id], 200.0);
+    EXPECT_EQ(set.size(), 1);
+    set.erase(other_id);
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(SparseSetTest, Ticks_FollowTheirValues)
+{
+    // GIVEN
+    sparse_set<float> set;
+    set.set_tick(1);
+    set.insert(1, 1.0);
+    set.insert(2, 2.0);
+
+    // WHEN
+    set.set_tick(2);
+    set.insert(2, 20.0);
+    set.emplace(3, 3.0);
+    set.erase(1);
+
+    // THEN
+    ASSERT_EQ(set.ticks().size(), 2);
+    const change_ticks& ticks2 { set.ticks()[set.index(2)] };
+    const change_ticks& ticks3 { set.ticks()[set.index(3)] };
+    EXPECT_EQ(ticks2.added, 1);
+    EXPECT_EQ(ticks2.changed, 2);
+    EXPECT_EQ(ticks3.added, 2);
+    EXPECT_EQ(ticks3.changed, 2);
+}
+
+TEST(SparseSetTest, Sort_ElementsAreOrderedByValueAndStable)
+{
+    // GIVEN
+    sparse_set<int> set;
+    const std::vector<int> values { 5, 3, 9, 3, 1, 7 };
+    for (u32 id { 0 }; id < values.size(); ++id) {
+        set.insert(id, values[id]);
+    }
+
+    // WHEN
+    set.sort([](const int lhs, const int rhs) { return lhs < rhs; });
+
+    // THEN
+    const std::vector<u32> expected_ids { 4, 1, 3, 0, 5, 2 };
+    ASSERT_EQ(set.size(), expected_ids.size());
+    for (u32 i { 0 }; i < expected_ids.size(); ++i) {
+        EXPECT_EQ(set.ids()[i], expected_ids[i]);
+        EXPECT_EQ(set.data()[i], values[expected_ids[i]]);
+        EXPECT_EQ(set.index(expected_ids[i]), i);
+        EXPECT_EQ(set[expected_ids[i]], values[expected_ids[i]]);
+    }
+}
+
+TEST(SparseSetTest, SortAs_SharedElementsFollowTheOtherOrder)
+{
+    // GIVEN
+    sparse_set<float> order;
+    order.insert(3, 0.0);
+    order.insert(9, 0.0);
+    order.insert(1, 0.0);
+
+    sparse_set<int> set;
+    set.insert(1, 10);
+    set.insert(2, 20);
+    set.insert(3, 30);
+
+    // WHEN
+    set.sort_as(order);
+
+    // THEN
+    ASSERT_EQ(set.size(), 3);
+    EXPECT_EQ(set.ids()[0], 3);
+    EXPECT_EQ(set.ids()[1], 1);
+    EXPECT_EQ(set.ids()[2], 2);
+    EXPECT_EQ(set[1], 10);
+    EXPECT_EQ(set[2], 20);
+    EXPECT_EQ(set[3], 30);
+}
+
+TEST(SparseSetTest, InsertRange_ValuesArePresentAndOverwritten)
+{
+    // GIVEN
+    sparse_set<int> set;
+    set.insert(2, -1);
+    const std::vector<u32> ids { 1, 2, 10'000 };
+    const std::vector<int> values { 10, 20, 30 };
+
+    // WHEN
+    set.insert(ids.begin(), ids.end(), values.begin());
+
+    // THEN
+    ASSERT_EQ(set.size(), 3);
+    EXPECT_EQ(set[1], 10);
+    EXPECT_EQ(set[2], 20);
+    EXPECT_EQ(set[10'000], 30);
+}
+
+TEST(SparseSetTest, EraseRange_ValuesAreRemoved)
+{
+    // GIVEN
+    sparse_set<int> set;
+    for (u32 id { 0 }; id < 5; ++id) {
+        set.insert(id, static_cast<int>(id));
+    }
+    const std::vector<u32> ids { 0, 3, 7 };
+
+    // WHEN
+    set.erase(ids.begin(), ids.end());
+
+    // THEN
+    ASSERT_EQ(set.size(), 3);
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_EQ(set[4], 4);
+}
+
+TEST(SparseSetTest, Clear_AllValuesAreRemoved)
+{
+    // GIVEN
+    sparse_set<int> set;
+    set.insert(1, 10);
+    set.insert(5'000, 20);
+
+    // WHEN
+    set.clear();
+
+    // THEN
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(1));
+    EXPECT_FALSE(set.contains(5'000));
+    set.insert(1, 30);
+    EXPECT_EQ(set[1], 30);
+}
+
+TEST(SparseSetTest, Hooks_InsertAndEraseAreNotified)
+{
+    // GIVEN
+    sparse_set<int> set;
+    std::vector<u32> inserted;
+    std::vector<u32> erased;
+    const auto record { [](void* context, const u32 id) {
+        static_cast<std::vector<u32>*>(context)->push_back(id);
+    } };
+    set.on_insert({ record, &inserted });
+    set.on_erase({ record, &erased });
+
+    // WHEN
+    set.insert(1, 10);
+    set.insert(1, 11);
+    set.emplace(2, 20);
+    set.erase(1);
+    set.erase(3);
+    set.clear();
+
+    // THEN
+    EXPECT_EQ(inserted, (std::vector<u32> { 1, 2 }));
+    EXPECT_EQ(erased, (std::vector<u32> { 1, 2 }));
+}
+
+TEST(SparseSetTest, Hooks_CopiesStayConnectedUntilDisconnected)
+{
+    // GIVEN
+    sparse_set<int> set;
+    std::vector<u32> inserted;
+    set.on_insert({ [](void* context, const u32 id) {
+                       static_cast<std::vector<u32>*>(context)->push_back(id);
+                   },
+        &inserted });
+    sparse_set<int> copy { set };
+
+    // WHEN
+    copy.insert(1, 10);
+    copy.disconnect(&inserted);
+    copy.insert(2, 20);
+
+    // THEN
+    EXPECT_EQ(inserted, (std::vector<u32> { 1 }));
+}
+
 } // namespace eecs::test
@@ -0,0 +1,243 @@
+#include "system_param.hpp"
+
+#include <optional>
+#include <vector>
+
+#include "access.hpp"
+#include "command_buffer.hpp"
+#include "entity.hpp"
+#include "schedule.hpp"
+#include "thread_pool.hpp"
+#include "view.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A velocity component. Only for testing purposes.
+    struct velocity {
+        int dx { 0 };
+    };
+
+    /// A gravity resource. Only for testing purposes.
+    struct gravity {
+        int value { 0 };
+    };
+
+    void integrate(view<position, const velocity> bodies)
+    {
+        bodies.each([](entity /*entity*/, position& position,
+                        const velocity& velocity) {
+            position.x += velocity.dx;
+        });
+    }
+
+} // namespace
+
+class SystemParamTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        for (int i { 0 }; i < 4; ++i) {
+            const entity entity { world.create() };
+            world.insert(entity, position { .x = i });
+            world.insert(entity, velocity { .dx = 1 });
+        }
+    }
+
+    world world;
+    thread_pool pool { 2 };
+    schedule schedule;
+};
+
+TEST_F(SystemParamTest, AddSystem_FunctionWithView_ViewIsInjected)
+{
+    // GIVEN
+    schedule.add_system(integrate);
+
+    // WHEN
+    schedule.run(world, pool);
+    schedule.run(world, pool);
+
+    // THEN
+    world.view<const position>(
+        [](entity entity, const position& position) {
+            EXPECT_EQ(position.x, static_cast<int>(entity) + 2);
+        });
+}
+
+TEST_F(SystemParamTest, AddSystem_ReadOnlyView_FrozenCollectionsAreShared)
+{
+    // GIVEN
+    int sum { 0 };
+    schedule.add_system([&sum](view<const position, const velocity> bodies) {
+        bodies.each([&sum](entity /*entity*/, const position& position,
+                        const velocity& /*velocity*/) { sum += position.x; });
+    });
+    const frozen_world frozen { world.freeze() };
+
+    // WHEN
+    schedule.run(world, pool);
+
+    // THEN
+    EXPECT_EQ(sum, 6);
+    const frozen_world again { world.freeze() };
+    EXPECT_EQ(again.components<position>(), frozen.components<position>());
+    EXPECT_EQ(again.components<velocity>(), frozen.components<velocity>());
+}
+
+TEST_F(SystemParamTest, AddSystem_LambdaWithState_StateIsKept)
+{
+    // GIVEN
+    world.emplace<gravity>(3);
+    std::vector<int> seen;
+    schedule.add_system(
+        [&seen, runs = 0](res<const gravity> gravity) mutable {
+            seen.push_back(gravity->value + runs++);
+        });
+
+    // WHEN
+    schedule.run(world);
+    world.emplace<gravity>(10);
+    schedule.run(world);
+
+    // THEN
+    EXPECT_EQ(seen, (std::vector<int> { 3, 11 }));
+}
+
+TEST_F(SystemParamTest, AddSystem_WorldRecreatedInPlace_StateIsResolvedAgain)
+{
+    // GIVEN
+    std::optional<eecs::world> other { std::in_place };
+    other->emplace<gravity>(3);
+    std::vector<int> seen;
+    schedule.add_system([&seen](res<const gravity> gravity) {
+        seen.push_back(gravity->value);
+    });
+    schedule.run(*other);
+
+    // WHEN
+    other.reset();
+    other.emplace().emplace<gravity>(10);
+    schedule.run(*other);
+
+    // THEN
+    EXPECT_EQ(seen, (std::vector<int> { 3, 10 }));
+}
+
+TEST_F(SystemParamTest, AddSystem_ChangedView_SeesChangesSinceLastRun)
+{
+    // GIVEN
+    std::vector<int> seen;
+    schedule.add_system(
+        [&seen](view<const position, changed<position>> positions) {
+            int count { 0 };
+            positions.each(
+                [&count](entity /*entity*/, const position& /*position*/) {
+                    ++count;
+                });
+            seen.push_back(count);
+        });
+    schedule.add_system([runs = 0](view<position> positions) mutable {
+        if (runs++ == 0) {
+            positions.each(
+                [](entity /*entity*/, position& position) { ++position.x; });
+        }
+    });
+
+    // WHEN
+    for (int frame { 0 }; frame < 3; ++frame) {
+        schedule.run(world);
+        world.advance_tick();
+    }
+
+    // THEN
+    EXPECT_EQ(seen, (std::vector<int> { 4, 4, 0 }));
+}
+
+TEST_F(SystemParamTest, AddSystem_Commands_ChangesAreFlushed)
+{
+    // GIVEN
+    world.emplace<command_buffer>();
+    schedule.add_system(
+        [](view<const position> positions, command_buffer& commands) {
+            positions.each([&commands](entity entity, const position&) {
+                commands.destroy(entity);
+            });
+        });
+
+    // WHEN
+    schedule.run(world, pool);
+
+    // THEN
+    EXPECT_EQ(world.size(), 0);
+}
+
+TEST_F(SystemParamTest, AddSystem_MissingResource_Throws)
+{
+    // GIVEN
+    schedule.add_system([](res<gravity> /*gravity*/) { });
+
+    // WHEN / THEN
+    EXPECT_THROW(schedule.run(world), std::out_of_range);
+}
+
+TEST(SystemParamAccessTest, ImpliedAccess_FollowsParameters)
+{
+    // GIVEN
+    const auto reader { [](view<const position> /*positions*/,
+                            res<const gravity> /*gravity*/) { } };
+    const auto writer { [](view<position> /*positions*/) { } };
+    const auto other { [](view<velocity> /*velocities*/,
+                           res<const gravity> /*gravity*/) { } };
+    const auto exclusive { [](world& /*world*/) { } };
+
+    // WHEN
+    const access read { param_system<decltype(reader)>::implied_access() };
+    const access write { param_system<decltype(writer)>::implied_access() };
+    const access unrelated { param_system<decltype(other)>::implied_access() };
+
+    // THEN
+    EXPECT_TRUE(read.conflicts_with(write));
+    EXPECT_FALSE(read.conflicts_with(unrelated));
+    EXPECT_FALSE(write.conflicts_with(unrelated));
+    EXPECT_TRUE(
+        param_system<decltype(exclusive)>::implied_access().exclusive());
+}
+
+TEST(SystemParamAccessTest, ImpliedAccess_FiltersReadTheirComponents)
+{
+    // GIVEN
+    const auto filtered { [](view<const position, exclude<velocity>>
+                                 /*positions*/) { } };
+    const auto optional { [](view<const position, maybe<velocity>>
+                                 /*positions*/) { } };
+    const auto writer { [](view<velocity> /*velocities*/) { } };
+
+    // WHEN
+    const access excluding {
+        param_system<decltype(filtered)>::implied_access()
+    };
+    const access maybe_writing {
+        param_system<decltype(optional)>::implied_access()
+    };
+    const access write { param_system<decltype(writer)>::implied_access() };
+
+    // THEN
+    EXPECT_TRUE(excluding.conflicts_with(write));
+    EXPECT_TRUE(maybe_writing.conflicts_with(write));
+    EXPECT_FALSE(
+        excluding.conflicts_with(access::of<reads<velocity>>()));
+    EXPECT_TRUE(
+        maybe_writing.conflicts_with(access::of<reads<velocity>>()));
+}
+
+} // namespace eecs::test
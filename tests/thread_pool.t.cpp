@@ -0,0 +1,100 @@
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+TEST(ThreadPoolTest, Submit_AllTasksAreRun)
+{
+    // GIVEN
+    thread_pool pool { 4 };
+    std::atomic<int> count { 0 };
+    constexpr int task_count { 1000 };
+
+    // WHEN
+    for (int i = 0; i < task_count; ++i) {
+        pool.submit([&count] { ++count; });
+    }
+    pool.wait_until([&count] { return count == task_count; });
+
+    // THEN
+    EXPECT_EQ(count, task_count);
+}
+
+TEST(ThreadPoolTest, Submit_WithoutWorkers_WaitingThreadRunsTasks)
+{
+    // GIVEN
+    thread_pool pool { 0 };
+    std::atomic<int> count { 0 };
+
+    // WHEN
+    pool.submit([&count] { ++count; });
+    pool.wait_until([&count] { return count == 1; });
+
+    // THEN
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(count, 1);
+}
+
+TEST(ThreadPoolTest, Submit_FromTask_NestedTasksAreRun)
+{
+    // GIVEN
+    thread_pool pool { 2 };
+    std::atomic<int> count { 0 };
+
+    // WHEN
+    pool.submit([&pool, &count] {
+        std::atomic<int> nested { 0 };
+        for (int i = 0; i < 10; ++i) {
+            pool.submit([&nested] { ++nested; });
+        }
+        pool.wait_until([&nested] { return nested == 10; });
+        count += nested;
+    });
+    pool.wait_until([&count] { return count == 10; });
+
+    // THEN
+    EXPECT_EQ(count, 10);
+}
+
+TEST(ThreadPoolTest, ParallelFor_EveryIndexIsVisitedOnce)
+{
+    // GIVEN
+    thread_pool pool { 4 };
+    std::vector<int> visits(1000, 0);
+
+    // WHEN
+    pool.parallel_for(visits.size(), 64,
+        [&visits](const std::size_t first, const std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                ++visits[i];
+            }
+        });
+
+    // THEN
+    for (const int count : visits) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelFor_ChunkThrows_ExceptionIsRethrown)
+{
+    // GIVEN
+    thread_pool pool { 2 };
+
+    // WHEN / THEN
+    EXPECT_THROW(pool.parallel_for(100, 10,
+                     [](const std::size_t first, const std::size_t /*last*/) {
+                         if (first == 50) {
+                             throw std::runtime_error("chunk failed");
+                         }
+                     }),
+        std::runtime_error);
+}
+
+} // namespace eecs::test
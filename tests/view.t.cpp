@@ -0,0 +1,283 @@
+#include "view.hpp"
+
+#include <vector>
+
+#include "entity.hpp"
+#include "thread_pool.hpp"
+#include "world.hpp"
+
+#include "gtest/gtest.h"
+
+namespace eecs::test {
+
+namespace {
+
+    /// A position component. Only for testing purposes.
+    struct position {
+        int x { 0 };
+    };
+
+    /// A tag component. Only for testing purposes.
+    struct tag { };
+
+    /// A velocity component. Only for testing purposes.
+    struct velocity {
+        int dx { 0 };
+    };
+
+} // namespace
+
+class ViewTest : public testing::Test {
+protected:
+    world world;
+};
+
+TEST_F(ViewTest, Each_OnlyMatchingEntitiesAreVisited)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    const entity entity3 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity3, position { .x = 3 });
+    world.insert(entity2, tag {});
+
+    // WHEN
+    std::vector<entity> visited;
+    world.view<position, tag>().each(
+        [&visited](const entity entity, position& /*unused*/, tag& /*unused*/) {
+            visited.push_back(entity);
+        });
+
+    // THEN
+    ASSERT_EQ(visited.size(), 1);
+    EXPECT_EQ(visited[0], entity2);
+}
+
+TEST_F(ViewTest, SizeHint_SmallestCollectionDrivesIteration)
+{
+    // GIVEN
+    for (int i = 0; i < 10; ++i) {
+        world.insert(world.create(), position { .x = i });
+    }
+    world.insert(3, tag {});
+
+    // WHEN
+    const auto view { world.view<position, tag>() };
+
+    // THEN
+    EXPECT_EQ(view.size_hint(), 1);
+    EXPECT_TRUE(view.contains(3));
+    EXPECT_FALSE(view.contains(4));
+}
+
+TEST_F(ViewTest, Iterator_YieldsEntityAndComponents)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity2, tag {});
+
+    // WHEN
+    int sum { 0 };
+    int count { 0 };
+    for (auto [entity, pos, _] : world.view<position, tag>()) {
+        EXPECT_EQ(entity, entity2);
+        pos.x *= 10;
+        sum += pos.x;
+        ++count;
+    }
+
+    // THEN
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(sum, 20);
+    EXPECT_EQ(world.components<position>()[entity2].x, 20);
+}
+
+TEST_F(ViewTest, ParEach_EveryMatchingEntityIsVisitedOnce)
+{
+    // GIVEN
+    constexpr int entity_count { 1000 };
+    for (int i = 0; i < entity_count; ++i) {
+        const entity entity { world.create() };
+        world.insert(entity, position { .x = i });
+        if (i % 3 == 0) {
+            world.insert(entity, tag {});
+        }
+    }
+    thread_pool pool { 4 };
+
+    // WHEN
+    world.view<tag, position>().par_each(
+        pool,
+        [](const entity /*unused*/, tag& /*unused*/, position& pos) {
+            pos.x = -pos.x;
+        },
+        16);
+
+    // THEN
+    world.view<position>([](const entity entity, const position& pos) {
+        const int x { static_cast<int>(entity) };
+        EXPECT_EQ(pos.x, x % 3 == 0 ? -x : x);
+    });
+}
+
+TEST_F(ViewTest, Added_OnlyComponentsInsertedThisTickMatch)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.advance_tick();
+    world.insert(entity2, position { .x = 2 });
+
+    // WHEN
+    std::vector<entity> visited;
+    world.view<added<position>>(
+        [&visited](const entity entity) { visited.push_back(entity); });
+
+    // THEN
+    ASSERT_EQ(visited.size(), 1);
+    EXPECT_EQ(visited[0], entity2);
+}
+
+TEST_F(ViewTest, Changed_OnlyWrittenComponentsMatch)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity2, tag {});
+    world.advance_tick();
+
+    // WHEN
+    world.view<const position>(
+        [](const entity /*unused*/, const position& /*unused*/) { });
+    world.view<position, const tag>(
+        [](const entity /*unused*/, position& pos, const tag& /*unused*/) {
+            pos.x *= 10;
+        });
+
+    // THEN
+    std::vector<entity> visited;
+    world.view<const position, changed<position>>(
+        [&visited](const entity entity, const position& pos) {
+            EXPECT_EQ(pos.x, 20);
+            visited.push_back(entity);
+        });
+    ASSERT_EQ(visited.size(), 1);
+    EXPECT_EQ(visited[0], entity2);
+    EXPECT_FALSE(world.view<changed<tag>>().contains(entity2));
+}
+
+TEST_F(ViewTest, Since_ChangesFromEarlierTicksMatch)
+{
+    // GIVEN
+    const u32 last_run { world.tick() };
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.advance_tick();
+    world.advance_tick();
+
+    // WHEN
+    const auto view { world.view<changed<position>>() };
+
+    // THEN
+    EXPECT_FALSE(view.contains(entity));
+    EXPECT_TRUE(view.since(last_run - 1).contains(entity));
+    EXPECT_FALSE(view.since(last_run).contains(entity));
+}
+
+TEST_F(ViewTest, Since_ChangesLaterInTheSameFrameMatch)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, position {});
+    world.advance_tick();
+    const u32 last_run { world.increment_tick() };
+
+    // WHEN
+    world.view<position>(
+        [](const eecs::entity /*unused*/, position& pos) { ++pos.x; });
+    world.advance_tick();
+
+    // THEN
+    const auto view { world.view<changed<position>>() };
+    EXPECT_FALSE(view.contains(entity));
+    EXPECT_TRUE(view.since(last_run).contains(entity));
+}
+
+TEST_F(ViewTest, Exclude_EntitiesWithExcludedComponentsAreSkipped)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    const entity entity3 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity3, position { .x = 3 });
+    world.insert(entity2, tag {});
+    world.insert(entity3, velocity {});
+
+    // WHEN
+    std::vector<entity> visited;
+    world.view<const position, exclude<tag, velocity>>().each(
+        [&visited](const entity entity, const position& /*unused*/) {
+            visited.push_back(entity);
+        });
+
+    // THEN
+    ASSERT_EQ(visited.size(), 1);
+    EXPECT_EQ(visited[0], entity1);
+    const auto view { world.view<position, exclude<tag>>() };
+    EXPECT_FALSE(view.contains(entity2));
+}
+
+TEST_F(ViewTest, Maybe_MissingComponentsYieldNull)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, position { .x = 1 });
+    world.insert(entity2, position { .x = 2 });
+    world.insert(entity2, velocity { .dx = 5 });
+    world.advance_tick();
+
+    // WHEN
+    world.view<position, maybe<velocity>>().each(
+        [](const entity /*entity*/, position& position, velocity* velocity) {
+            if (velocity != nullptr) {
+                position.x += velocity->dx;
+                velocity->dx = 0;
+            }
+        });
+
+    // THEN
+    const auto& positions { world.components<position>() };
+    const auto& velocities { world.components<velocity>() };
+    EXPECT_EQ(positions[entity1].x, 1);
+    EXPECT_EQ(positions[entity2].x, 7);
+    EXPECT_EQ(velocities[entity2].dx, 0);
+    EXPECT_EQ(velocities.ticks()[0].changed, world.tick());
+}
+
+TEST_F(ViewTest, SizeHint_OnlyRequiredCollectionsDriveIteration)
+{
+    // GIVEN
+    for (int i = 0; i < 10; ++i) {
+        world.insert(world.create(), position { .x = i });
+    }
+    world.insert(3, tag {});
+
+    // WHEN
+    const auto view { world.view<position, exclude<tag>, maybe<velocity>>() };
+
+    // THEN
+    EXPECT_EQ(view.size_hint(), 10);
+}
+
+} // namespace eecs::test
@@ -1,5 +1,11 @@
 #include "world.hpp"
 
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "entity.hpp"
 #include "sparse_set.hpp"
 
 #include "gtest/gtest.h"
@@ -24,6 +30,16 @@ struct window_resource {
     int height { 0 };
 };
 
+/// Records the entities a hook is notified of. Only for testing purposes.
+struct recorder {
+    std::vector<entity> entities;
+
+    static void record(void* context, const entity entity)
+    {
+        static_cast<recorder*>(context)->entities.push_back(entity);
+    }
+};
+
 class WorldTest : public testing::Test {
 protected:
     world world;
@@ -43,6 +59,55 @@ TEST_F(WorldTest, CreateEntity_EntityIsIncremented)
     EXPECT_EQ(entity2, entity1 + 1);
 }
 
+TEST_F(WorldTest, DestroyEntity_ComponentsAreRemoved)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, vec2 {});
+    world.insert(entity, texture2 { .id = 1 });
+
+    // WHEN
+    world.destroy(entity);
+
+    // THEN
+    EXPECT_FALSE(world.valid(entity));
+    EXPECT_FALSE(world.components<vec2>().contains(entity));
+    EXPECT_FALSE(world.components<texture2>().contains(entity));
+}
+
+TEST_F(WorldTest, CreateEntity_AfterDestroy_IndexIsRecycled)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    world.insert(entity1, vec2 {});
+    world.destroy(entity1);
+
+    // WHEN
+    const entity entity2 { world.create() };
+
+    // THEN
+    using traits = id_traits<entity>;
+    EXPECT_EQ(traits::to_index(entity2), traits::to_index(entity1));
+    EXPECT_EQ(traits::to_version(entity2), traits::to_version(entity1) + 1);
+    EXPECT_TRUE(world.valid(entity2));
+    EXPECT_FALSE(world.valid(entity1));
+    EXPECT_FALSE(world.components<vec2>().contains(entity2));
+}
+
+TEST_F(WorldTest, Size_CountsAliveEntities)
+{
+    // GIVEN
+    const entity destroyed { world.create() };
+    static_cast<void>(world.create(3));
+
+    // WHEN
+    world.destroy(destroyed);
+    static_cast<void>(world.create());
+
+    // THEN
+    EXPECT_EQ(world.size(), 4);
+}
+
 TEST_F(WorldTest, AddComponent_ComponentIsPresent)
 {
     // GIVEN
@@ -88,6 +153,16 @@ TEST_F(WorldTest, AddResource_ExistingResource_ResourceIsUpdated)
     EXPECT_EQ(window.height, height);
 }
 
+TEST_F(WorldTest, Resource_MissingResource_Throws)
+{
+    // GIVEN
+    // ...
+
+    // WHEN / THEN
+    EXPECT_THROW(static_cast<void>(world.resource<window_resource>()),
+        std::out_of_range);
+}
+
 TEST_F(WorldTest, View_ComponentsAreUpdated)
 {
     // GIVEN
@@ -104,4 +179,326 @@ TEST_F(WorldTest, View_ComponentsAreUpdated)
     }
 }
 
+TEST_F(WorldTest, Removed_ReportsErasedAndDestroyedUntilNextTick)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, vec2 {});
+    world.insert(entity2, vec2 {});
+
+    // WHEN
+    world.erase<vec2>(entity1);
+    world.erase<vec2>(entity1);
+    world.destroy(entity2);
+
+    // THEN
+    const auto removed { world.removed<vec2>() };
+    ASSERT_EQ(removed.size(), 2);
+    EXPECT_EQ(removed[0], entity1);
+    EXPECT_EQ(removed[1], entity2);
+
+    world.advance_tick();
+    EXPECT_TRUE(world.removed<vec2>().empty());
+}
+
+TEST_F(WorldTest, RemovedSince_RemovalsAreKeptForAnotherFrame)
+{
+    // GIVEN
+    const u32 last_read { world.increment_tick() };
+    const entity entity { world.create() };
+    world.insert(entity, vec2 {});
+    world.erase<vec2>(entity);
+
+    // WHEN
+    world.advance_tick();
+
+    // THEN
+    const auto removed { world.removed<vec2>(last_read) };
+    ASSERT_EQ(removed.size(), 1);
+    EXPECT_EQ(removed[0], entity);
+    EXPECT_TRUE(world.removed<vec2>(world.tick()).empty());
+
+    world.advance_tick();
+    EXPECT_TRUE(world.removed<vec2>(last_read).empty());
+}
+
+TEST_F(WorldTest, CreateMany_IndicesAreRecycledFirst)
+{
+    // GIVEN
+    const entity entity1 { world.create() };
+    world.create();
+    world.destroy(entity1);
+
+    // WHEN
+    const std::vector<entity> entities { world.create(3) };
+
+    // THEN
+    using traits = id_traits<entity>;
+    ASSERT_EQ(entities.size(), 3);
+    EXPECT_EQ(traits::to_index(entities[0]), 0);
+    EXPECT_EQ(traits::to_version(entities[0]), 1);
+    EXPECT_EQ(entities[1], 2);
+    EXPECT_EQ(entities[2], 3);
+    for (const entity entity : entities) {
+        EXPECT_TRUE(world.valid(entity));
+    }
+}
+
+TEST_F(WorldTest, CreateMany_MoreThanAMillionEntities_AllAreValid)
+{
+    // GIVEN
+    constexpr std::size_t count { std::size_t { 1 } << 21 };
+
+    // WHEN
+    const std::vector<entity> entities { world.create(count) };
+
+    // THEN
+    using traits = id_traits<entity>;
+    ASSERT_EQ(world.size(), count);
+    EXPECT_EQ(traits::to_index(entities.back()), count - 1);
+    EXPECT_TRUE(world.valid(entities.back()));
+}
+
+TEST_F(WorldTest, InsertMany_ComponentsArePresent)
+{
+    // GIVEN
+    const std::vector<entity> entities { world.create(100) };
+    std::vector<vec2> vecs;
+    for (std::size_t i { 0 }; i < entities.size(); ++i) {
+        vecs.push_back(vec2 { .x = static_cast<float>(i) });
+    }
+
+    // WHEN
+    world.insert<vec2>(entities, vecs);
+    world.erase<vec2>(std::span { entities }.first(50));
+
+    // THEN
+    const sparse_set<vec2>& components { world.components<vec2>() };
+    ASSERT_EQ(components.size(), 50);
+    for (std::size_t i { 50 }; i < entities.size(); ++i) {
+        EXPECT_EQ(components[entities[i]], vecs[i]);
+    }
+    EXPECT_EQ(world.removed<vec2>().size(), 50);
+}
+
+TEST_F(WorldTest, Freeze_LaterWritesAreNotObserved)
+{
+    // GIVEN
+    const entity kept { world.create() };
+    const entity destroyed { world.create() };
+    world.insert(kept, vec2 { .x = 1.0 });
+    world.insert(destroyed, vec2 { .x = 2.0 });
+
+    // WHEN
+    const frozen_world frozen { world.freeze() };
+    world.components<vec2>()[kept].x = 3.0;
+    world.destroy(destroyed);
+
+    // THEN
+    EXPECT_TRUE(frozen.valid(destroyed));
+    ASSERT_NE(frozen.components<vec2>(), nullptr);
+    EXPECT_EQ((*frozen.components<vec2>())[kept].x, 1.0);
+    EXPECT_EQ(frozen.components<vec2>()->size(), 2);
+    EXPECT_EQ(world.components<vec2>()[kept].x, 3.0);
+    EXPECT_EQ(frozen.components<texture2>(), nullptr);
+}
+
+TEST_F(WorldTest, Freeze_UnwrittenCollectionsAreShared)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, vec2 {});
+    world.insert(entity, texture2 { .id = 1 });
+    const sparse_set<texture2>* textures { &world.components<texture2>() };
+
+    // WHEN
+    const frozen_world frozen { world.freeze() };
+    world.components<vec2>()[entity].x = 1.0;
+
+    // THEN
+    EXPECT_EQ(frozen.components<texture2>(), textures);
+    EXPECT_NE(frozen.components<vec2>(), &world.components<vec2>());
+}
+
+TEST_F(WorldTest, Freeze_ReadOnlyViewsDoNotCopyCollections)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, vec2 { .x = 1.0 });
+    world.insert(entity, texture2 { .id = 1 });
+    const frozen_world frozen { world.freeze() };
+
+    // WHEN
+    float x { 0.0 };
+    world.view<const vec2, exclude<window_resource>, maybe<const texture2>>(
+        [&x](const eecs::entity /*entity*/, const vec2& position,
+            const texture2* /*texture*/) { x = position.x; });
+
+    // THEN
+    EXPECT_EQ(x, 1.0);
+    const frozen_world again { world.freeze() };
+    EXPECT_EQ(again.components<vec2>(), frozen.components<vec2>());
+    EXPECT_EQ(again.components<texture2>(), frozen.components<texture2>());
+}
+
+TEST_F(WorldTest, Freeze_Each_VisitsMatchingEntities)
+{
+    // GIVEN
+    const entity both { world.create() };
+    const entity single { world.create() };
+    world.insert(both, vec2 { .x = 1.0 });
+    world.insert(both, texture2 { .id = 1 });
+    world.insert(single, vec2 { .x = 2.0 });
+    const frozen_world frozen { world.freeze() };
+    world.erase<texture2>(both);
+
+    // WHEN
+    std::vector<entity> visited;
+    frozen.each<vec2, texture2>(
+        [&visited](const entity entity, const vec2& /*vec*/,
+            const texture2& /*texture*/) { visited.push_back(entity); });
+
+    // THEN
+    EXPECT_EQ(visited, std::vector<entity> { both });
+}
+
+TEST_F(WorldTest, Freeze_GroupFollowsWrites)
+{
+    // GIVEN
+    const entity entity { world.create() };
+    world.insert(entity, vec2 {});
+    world.insert(entity, texture2 { .id = 1 });
+    auto group { world.group<vec2, texture2>() };
+    const frozen_world frozen { world.freeze() };
+
+    // WHEN
+    group.each([](eecs::entity /*entity*/, vec2& vec, texture2& /*texture*/) {
+        vec.x = 1.0;
+    });
+
+    // THEN
+    EXPECT_EQ((*frozen.components<vec2>())[entity].x, 0.0);
+    EXPECT_EQ(world.components<vec2>()[entity].x, 1.0);
+}
+
+TEST_F(WorldTest, Hooks_LifecycleIsNotified)
+{
+    // GIVEN
+    recorder constructed;
+    recorder updated;
+    recorder destroyed;
+    world.on_construct<vec2>({ &recorder::record, &constructed });
+    world.on_update<vec2>({ &recorder::record, &updated });
+    world.on_destroy<vec2>({ &recorder::record, &destroyed });
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    const entity entity3 { world.create() };
+
+    // WHEN
+    world.insert(entity1, vec2 {});
+    world.emplace<vec2>(entity2, 1.0F, 2.0F);
+    world.insert(entity1, vec2 { .x = 3.0 });
+    world.emplace<vec2>(entity2);
+    world.insert(entity3, texture2 { .id = 1 });
+    world.erase<vec2>(entity1);
+    world.destroy(entity2);
+    world.destroy(entity3);
+
+    // THEN
+    EXPECT_EQ(constructed.entities, (std::vector<entity> { entity1, entity2 }));
+    EXPECT_EQ(updated.entities, (std::vector<entity> { entity1, entity2 }));
+    EXPECT_EQ(destroyed.entities, (std::vector<entity> { entity1, entity2 }));
+}
+
+TEST_F(WorldTest, OnDestroy_ComponentIsStillReadable)
+{
+    // GIVEN
+    struct observer {
+        eecs::world* world;
+        std::vector<float> xs;
+    } observed { .world = &world, .xs = {} };
+    world.on_destroy<vec2>({ [](void* context, const entity entity) {
+                                auto& self { *static_cast<observer*>(context) };
+                                self.xs.push_back(
+                                    self.world->components<vec2>()[entity].x);
+                            },
+        &observed });
+    const entity entity { world.create() };
+    world.insert(entity, vec2 { .x = 4.0 });
+
+    // WHEN
+    world.clear();
+
+    // THEN
+    EXPECT_EQ(observed.xs, (std::vector<float> { 4.0 }));
+}
+
+TEST_F(WorldTest, Clear_ClearedEntitiesAreNoLongerValid)
+{
+    // GIVEN
+    const entity destroyed { world.create() };
+    world.destroy(destroyed);
+    const entity cleared { world.create() };
+    const entity other { world.create() };
+
+    // WHEN
+    world.clear();
+    const std::vector<entity> entities { world.create(3) };
+
+    // THEN
+    EXPECT_EQ(world.size(), 3);
+    EXPECT_FALSE(world.valid(destroyed));
+    EXPECT_FALSE(world.valid(cleared));
+    EXPECT_FALSE(world.valid(other));
+    for (const entity entity : entities) {
+        EXPECT_TRUE(world.valid(entity));
+    }
+    using traits = id_traits<entity>;
+    EXPECT_EQ(traits::to_index(entities[0]), 0);
+    EXPECT_EQ(traits::to_version(entities[0]), 2);
+    EXPECT_EQ(traits::to_index(entities[2]), 2);
+}
+
+TEST_F(WorldTest, OnDestroy_HookRegisteringNewTypes_AllAreErased)
+{
+    // GIVEN
+    struct first { };
+    struct second { };
+    world.on_destroy<vec2>({ [](void* context, const entity /*unused*/) {
+                                auto& world { *static_cast<eecs::world*>(
+                                    context) };
+                                static_cast<void>(world.removed<first>());
+                                static_cast<void>(world.removed<second>());
+                            },
+        &world });
+    const entity entity1 { world.create() };
+    const entity entity2 { world.create() };
+    world.insert(entity1, vec2 {});
+    world.insert(entity2, vec2 {});
+
+    // WHEN
+    world.destroy(entity1);
+    world.clear();
+
+    // THEN
+    EXPECT_EQ(world.size(), 0);
+    EXPECT_TRUE(world.components<vec2>().empty());
+}
+
+TEST_F(WorldTest, Disconnect_HooksAreNoLongerNotified)
+{
+    // GIVEN
+    recorder constructed;
+    world.on_construct<vec2>({ &recorder::record, &constructed });
+    world.insert(world.create(), vec2 {});
+
+    // WHEN
+    world.disconnect<vec2>(&constructed);
+    world.insert(world.create(), vec2 {});
+
+    // THEN
+    EXPECT_EQ(constructed.entities.size(), 1);
+}
+
 } // namespace eecs::test